@@ -0,0 +1,200 @@
+/**
+ * @file       bench.cpp
+ * @version    0.1
+ * @date       June 2022
+ * @author     Joeri Kok
+ * @author     Rick Horeman
+ * @copyright  GPL-3.0 license
+ *
+ * @brief Benchmarks of the configuration items, the configuration file, and the menu.
+ * @details Results are written as JSON by passing --benchmark_out=<file> and
+ *     --benchmark_out_format=json, so that they can be compared between revisions.
+ */
+
+#include "config.h"
+#include "menu.h"
+#include "xml.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+using namespace cfg::literals;
+
+/**
+ * @brief Sets a configuration item from a string, alternating between two values so
+ *     that every iteration changes the value.
+ * @tparam Item Configuration item type.
+ * @param[in] state Benchmark state.
+ * @param[in] first First value, represented as a string.
+ * @param[in] second Second value, represented as a string.
+ */
+template<typename Item>
+auto set_string(
+    benchmark::State& state, std::string_view first, std::string_view second
+) -> void {
+    auto item = Item{};
+    auto flip = false;
+    for (auto _ : state) {
+        item.set((flip = not flip) ? first : second);
+        benchmark::DoNotOptimize(item);
+    }
+}
+
+/**
+ * @brief Returns the path of a file in the temporary directory.
+ * @param[in] name Name of the file.
+ */
+auto temporary(std::string_view name) -> std::string
+{ return (std::filesystem::temp_directory_path() / name).string(); }
+
+/**
+ * @brief Returns the default settings, stored in the given file.
+ * @param[in] name Name of the file in the temporary directory.
+ */
+auto stored_settings(std::string_view name) -> cfg::config {
+    auto settings = cfg::config::defaults();
+    settings.xml.filename = temporary(name);
+    xml::write(settings.xml.filename, settings.toxml());
+    return settings;
+}
+
+/**
+ * @brief Number of distinct keys of menu options.
+ * @details Keys are single characters, so a menu with more options than this has
+ *     options that share the key of an earlier option, see ui::menu::add. Selecting
+ *     among 1000 options therefore selects among the first 256 of them.
+ */
+constexpr auto max_keys = std::size_t{256};
+
+/**
+ * @brief Returns configuration items with distinct names to add to a menu, one for
+ *     every menu option.
+ * @param[in] state Benchmark state, of which the first range is the number of options.
+ * @param[out] names Storage of the names, which the items refer to.
+ */
+auto menu_items(benchmark::State const& state, std::vector<std::string>& names)
+    -> std::vector<cfg::intitem>
+{
+    auto const count = static_cast<std::size_t>(state.range(0));
+    auto items = std::vector<cfg::intitem>{};
+    names.reserve(count);
+    items.reserve(count);
+    for (auto index = std::size_t{}; index < count; ++index) {
+        auto const& name = names.emplace_back("item-" + std::to_string(index));
+        items.push_back({cfg::item_name{name, name}, static_cast<int>(index)});
+    }
+    return items;
+}
+
+/**
+ * @brief Returns a menu with a menu option for every given configuration item, with
+ *     keys that repeat after max_keys options.
+ * @param[in] items Configuration items to add.
+ */
+auto make_menu(std::vector<cfg::intitem>& items) -> ui::menu<cfg::item_ref, ui::action> {
+    auto menu = ui::menu<cfg::item_ref, ui::action>{};
+    for (auto index = std::size_t{}; index < items.size(); ++index) {
+        auto const key = static_cast<unsigned char>(index % max_keys);
+        menu.add(key, cfg::item_ref{items[index]});
+    }
+    return menu;
+}
+
+auto bm_set_bool(benchmark::State& state) -> void
+{ set_string<cfg::boolitem>(state, "true", "false"); }
+
+auto bm_set_uint8(benchmark::State& state) -> void
+{ set_string<cfg::uint8item>(state, "128", "255"); }
+
+auto bm_set_int(benchmark::State& state) -> void
+{ set_string<cfg::intitem>(state, "115200", "-9600"); }
+
+auto bm_set_double(benchmark::State& state) -> void
+{ set_string<cfg::doubleitem>(state, "0.001", "5.25"); }
+
+auto bm_set_variant(benchmark::State& state) -> void
+{ set_string<cfg::cfgitem>(state, "1", "0"); }
+
+auto bm_set_enum(benchmark::State& state) -> void
+{ set_string<cfg::formatitem>(state, "Gray", "RGB"); }
+
+auto bm_to_string(benchmark::State& state) -> void {
+    auto const item = cfg::doubleitem{"item"_name, 0.001};
+    for (auto _ : state) benchmark::DoNotOptimize(item.to<std::string>());
+}
+
+auto bm_to_value(benchmark::State& state) -> void {
+    auto item = cfg::cfgitem{"item"_name, 42};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(item);
+        benchmark::DoNotOptimize(static_cast<double>(item));
+    }
+}
+
+auto bm_tagname(benchmark::State& state) -> void {
+    auto item = cfg::intitem{"frame width"_name, 640};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(item);
+        benchmark::DoNotOptimize(item.tagname());
+    }
+}
+
+auto bm_loadxml(benchmark::State& state) -> void {
+    auto settings = stored_settings("cfgmenu_bench_load.xml");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(settings.loadxml());
+        benchmark::ClobberMemory();
+    }
+}
+
+auto bm_savexml(benchmark::State& state) -> void {
+    auto settings = stored_settings("cfgmenu_bench_save.xml");
+    auto flip = false;
+    for (auto _ : state) {
+        settings.pid.kp.set((flip = not flip) ? 0.3 : 0.4);
+        settings.savexml();
+    }
+}
+
+auto bm_menu_select(benchmark::State& state) -> void {
+    auto names = std::vector<std::string>{};
+    auto items = menu_items(state, names);
+    auto menu = make_menu(items);
+    auto const keys = std::min(items.size(), max_keys);
+    auto key = std::size_t{};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(menu.select(static_cast<unsigned char>(key)));
+        if (++key == keys) key = 0;
+    }
+}
+
+auto bm_menu_to_string(benchmark::State& state) -> void {
+    auto names = std::vector<std::string>{};
+    auto items = menu_items(state, names);
+    auto const menu = make_menu(items);
+    for (auto _ : state) benchmark::DoNotOptimize(menu.to<std::string>());
+}
+
+} // namespace
+
+BENCHMARK(bm_set_bool);
+BENCHMARK(bm_set_uint8);
+BENCHMARK(bm_set_int);
+BENCHMARK(bm_set_double);
+BENCHMARK(bm_set_variant);
+BENCHMARK(bm_set_enum);
+BENCHMARK(bm_to_string);
+BENCHMARK(bm_to_value);
+BENCHMARK(bm_tagname);
+BENCHMARK(bm_loadxml);
+BENCHMARK(bm_savexml);
+BENCHMARK(bm_menu_select)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(bm_menu_to_string)->Arg(10)->Arg(100)->Arg(1000);
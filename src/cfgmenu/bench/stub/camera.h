@@ -0,0 +1,30 @@
+/**
+ * @file       camera.h
+ * @version    0.1
+ * @date       June 2022
+ * @author     Joeri Kok
+ * @author     Rick Horeman
+ * @copyright  GPL-3.0 license
+ *
+ * @brief Stand-in for the camera interface of the application, providing only what
+ *     the configuration refers to.
+ */
+
+#ifndef CAM_CAMERA_H
+#define CAM_CAMERA_H
+
+/**
+ * @namespace cam
+ * @brief Camera related components.
+ */
+namespace cam {
+
+/**
+ * @enum format
+ * @brief Image color format.
+ */
+enum class format { Gray, RGB };
+
+} // namespace cam
+
+#endif
@@ -0,0 +1,25 @@
+/**
+ * @file       ofFileUtils.h
+ * @version    0.1
+ * @date       June 2022
+ * @author     Joeri Kok
+ * @author     Rick Horeman
+ * @copyright  GPL-3.0 license
+ *
+ * @brief Stand-in for the openFrameworks file utilities, providing only what the
+ *     configuration refers to.
+ */
+
+#ifndef OF_FILE_UTILS_H
+#define OF_FILE_UTILS_H
+
+#include <string>
+
+/**
+ * @brief Returns the given path as is, instead of relative to the data directory.
+ * @param[in] path Path to a file.
+ */
+inline auto ofToDataPath(std::string const& path) -> std::string
+{ return path; }
+
+#endif
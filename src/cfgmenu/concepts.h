@@ -13,10 +13,13 @@
 #define CC_CONCEPTS_H
 
 #include "traits.h"
+#include "types.h"
 
 #include <concepts>
+#include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 
 /**
  * @namespace cc
@@ -29,13 +32,35 @@ namespace cc {
  * @tparam T Type to check.
  */
 template<typename T>
-concept configurable = requires(T item, std::string_view value) {
-    { item.name() } -> std::same_as<std::string const&>;
-    { item.tagname() } -> std::same_as<std::string>;
+concept configurable = requires(T item, std::string_view value, std::span<char> buffer) {
+    { item.name() } -> std::same_as<std::string_view>;
+    { item.tagname() } -> std::same_as<std::string_view>;
     { item.template to<std::string>() } -> std::same_as<std::string>;
+    { item.format_to(buffer) } -> std::same_as<std::string_view>;
     { item.set(value) } -> std::same_as<void>;
 };
 
+/**
+ * @brief Constrains a type to be a handle to a configurable item.
+ * @details A handle refers to a configuration item rather than containing one, and is
+ *     therefore meant to be passed around by value. Marked by a static is_handle member.
+ * @tparam T Type to check.
+ */
+template<typename T>
+concept configurable_handle = configurable<T> and std::copyable<T> and requires {
+    requires T::is_handle;
+};
+
+/**
+ * @brief Constrains a type to be configurable and to keep a revision number that
+ *     changes whenever its value changes.
+ * @tparam T Type to check.
+ */
+template<typename T>
+concept revisioned = configurable<T> and requires(T const item) {
+    { item.revision() } -> std::same_as<uint32>;
+};
+
 /**
  * @brief Constrains a type to be an integral or floating point type.
  * @tparam T Type to check.
@@ -44,12 +69,27 @@ template<typename T>
 concept arithmetic = std::integral<T> or std::floating_point<T>;
 
 /**
- * @brief Constrains all the given types to be distinct.
+ * @brief Constrains a type to be a scoped enumeration.
  * @tparam T Type to check.
- * @tparam Ts One or more types to check against.
  */
-template<typename T, typename... Ts>
-concept distinct = tt::is_distinct_v<T, Ts...>;
+template<typename T>
+concept scoped_enum = std::is_enum_v<T>
+    and not std::convertible_to<T, std::underlying_type_t<T>>;
+
+/**
+ * @brief Constrains a type to be valid as the value of a configuration item, i.e. an
+ *     arithmetic type or a scoped enumeration.
+ * @tparam T Type to check.
+ */
+template<typename T>
+concept item_value = arithmetic<T> or scoped_enum<T>;
+
+/**
+ * @brief Constrains all the given types to be distinct.
+ * @tparam Ts One or more types to check.
+ */
+template<typename... Ts>
+concept distinct = tt::is_distinct_v<Ts...>;
 
 /**
  * @brief Constrains a type to be convertible to all the given types.
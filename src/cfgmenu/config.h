@@ -14,21 +14,38 @@
 
 #include "camera.h"
 #include "concepts.h"
+#include "reflect.h"
 #include "types.h"
 #include "utility.h"
+#include "xml.h"
 
-#include <ofxXmlSettings.h>
+#include <ofFileUtils.h>
 
 #include <algorithm>
+#include <array>
 #include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <concepts>
 #include <format>
+#include <iterator>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <variant>
+#include <vector>
 
 /**
  * @namespace cfg
@@ -36,16 +53,234 @@
  */
 namespace cfg {
 
+/**
+ * @struct item_name
+ * @brief Name of a configuration item.
+ * @details Both views refer to storage with static duration, see operator""_name.
+ */
+struct item_name {
+    /**
+     * @brief Compares two objects for equality.
+     */
+    [[nodiscard]]
+    friend auto operator==(item_name const&, item_name const&) -> bool = default;
+
+    std::string_view name; /**< Name of the setting. */
+    std::string_view tag;  /**< Name of the setting, with spaces replaced by hyphens. */
+};
+
+/**
+ * @var tagname_v
+ * @brief Tag name of a setting, computed at compile time.
+ * @tparam Name Name of the setting.
+ */
+template<util::fixed_string Name>
+inline constexpr auto tagname_v = [] {
+    auto tag = Name;
+    std::ranges::replace(tag.data, ' ', '-');
+    return tag;
+}();
+
+/**
+ * @namespace literals
+ * @brief Configuration related literals.
+ */
+inline namespace literals {
+
+/**
+ * @brief Literal for the name of a configuration item.
+ * @details The tag name is derived at compile time, so that neither the name nor the
+ *     tag name requires any storage besides the views. A name whose tag name is not a
+ *     valid XML tag name fails to compile, see xml::valid_name.
+ * @tparam Name Name of the setting.
+ */
+template<util::fixed_string Name>
+consteval auto operator""_name() -> item_name {
+    if (not xml::valid_name(tagname_v<Name>.view())) throw "name is not a valid tag name";
+    return {Name.view(), tagname_v<Name>.view()};
+}
+
+} // namespace literals
+
+/**
+ * @brief Number of characters that suffices to represent any configuration value.
+ */
+inline constexpr auto max_value_chars = std::size_t{32};
+
+/**
+ * @brief Writes an arithmetic value as a string into the given buffer, without
+ *     allocating.
+ * @details Boolean values are written as "true" or "false", and floating point values
+ *     in their shortest round-trip representation.
+ * @param[in] value Arithmetic value to write.
+ * @param[out] buffer Buffer to write into, see max_value_chars.
+ * @return View of the written characters within the buffer, or an empty view when the
+ *     buffer is too small.
+ */
+[[nodiscard]]
+constexpr auto format_value(cc::arithmetic auto value, std::span<char> buffer) noexcept
+    -> std::string_view
+{
+    if constexpr (std::same_as<decltype(value), bool>) {
+        auto const text = std::string_view{value ? "true" : "false"};
+        if (text.size() > buffer.size()) return {};
+        std::ranges::copy(text, buffer.begin());
+        return {buffer.data(), text.size()};
+    } else {
+        auto const [end, error] =
+            std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+        if (error != std::errc{}) return {};
+        return {buffer.data(), static_cast<std::size_t>(end - buffer.data())};
+    }
+}
+
+/**
+ * @brief Writes the name of an enumerator into the given buffer, without allocating.
+ * @details The names are generated at compile time, see refl::enum_names_v.
+ * @param[in] value Enumerator to write.
+ * @param[out] buffer Buffer to write into, see max_value_chars.
+ * @return View of the written characters within the buffer, or an empty view when the
+ *     value has no enumerator or the buffer is too small.
+ */
+[[nodiscard]]
+constexpr auto format_value(cc::scoped_enum auto value, std::span<char> buffer) noexcept
+    -> std::string_view
+{
+    auto const name = refl::enum_name(value);
+    if (name.size() > buffer.size()) return {};
+    std::ranges::copy(name, buffer.begin());
+    return {buffer.data(), name.size()};
+}
+
+/**
+ * @enum parse_status
+ * @brief Outcome of parsing a value from a string.
+ */
+enum class parse_status : uint8 {
+    ok,          /**< The whole string represents a value. */
+    invalid,     /**< The string does not, or not entirely, represent a value. */
+    out_of_range /**< The string represents a value that does not fit the value type. */
+};
+
+/**
+ * @brief Parses an arithmetic value from a string.
+ * @details Boolean values are represented by "1" or "true", and "0" or "false". The
+ *     value is only changed when the whole string represents a value that fits the
+ *     value type, and is left unchanged otherwise.
+ * @param[in] text String that represents an arithmetic value.
+ * @param[out] value Arithmetic value to parse into.
+ * @return Whether the string represents a value that fits the value type. Can be
+ *     ignored at no cost when only the value is of interest.
+ */
+constexpr auto parse_value(std::string_view text, cc::arithmetic auto& value) noexcept
+    -> parse_status
+{
+    if constexpr (std::same_as<std::remove_cvref_t<decltype(value)>, bool>) {
+        auto const truth = text == "1" or text == "true";
+        if (not truth and text != "0" and text != "false") return parse_status::invalid;
+        value = truth;
+        return parse_status::ok;
+    } else {
+        auto parsed = std::remove_cvref_t<decltype(value)>{};
+        auto const last = text.data() + text.size();
+        auto const [end, error] = std::from_chars(text.data(), last, parsed);
+        if (error == std::errc::result_out_of_range) return parse_status::out_of_range;
+        if (error != std::errc{} or end != last) return parse_status::invalid;
+        value = parsed;
+        return parse_status::ok;
+    }
+}
+
+/**
+ * @brief Parses an enumerator from its name, or from its underlying value.
+ * @details Looks up the name by a perfect hash that is generated at compile time, see
+ *     refl::enum_cast. Underlying values are accepted as well, e.g. as written by
+ *     earlier versions, as long as they have an enumerator. The value is left
+ *     unchanged otherwise.
+ * @param[in] text Name or underlying value of an enumerator.
+ * @param[out] value Enumerator to parse into.
+ * @return Whether the string represents an enumerator.
+ */
+constexpr auto parse_value(std::string_view text, cc::scoped_enum auto& value) noexcept
+    -> parse_status
+{
+    using enum_type = std::remove_cvref_t<decltype(value)>;
+    if (auto const parsed = refl::enum_cast<enum_type>(text)) {
+        value = *parsed;
+        return parse_status::ok;
+    }
+    auto underlying = std::underlying_type_t<enum_type>{};
+    auto const status = parse_value(text, underlying);
+    if (status != parse_status::ok) return status;
+    if (refl::enum_name(static_cast<enum_type>(underlying)).empty()) {
+        return parse_status::out_of_range;
+    }
+    value = static_cast<enum_type>(underlying);
+    return parse_status::ok;
+}
+
+/**
+ * @brief Converts an arithmetic value to the given value type, clamped to the range of
+ *     the value type.
+ * @details Unlike a plain conversion, a value that does not fit the value type is well
+ *     defined, e.g. stepping a uint8 setting past 255 results in 255. Integers converted
+ *     from a floating point value are truncated, and are zero for not-a-number. Any
+ *     non-zero value converts to true.
+ * @tparam Value Value-type to convert to.
+ * @param[in] value Arithmetic value to convert.
+ */
+template<cc::arithmetic Value>
+[[nodiscard]]
+auto clamp_value(cc::arithmetic auto value) noexcept -> Value {
+    using source_type = decltype(value);
+    using limits = std::numeric_limits<Value>;
+    if constexpr (std::same_as<Value, bool>) {
+        return value != source_type{};
+    } else if constexpr (std::same_as<source_type, bool> or std::floating_point<Value>) {
+        if constexpr (std::floating_point<source_type>) {
+            if (std::isfinite(value)) value = std::clamp<source_type>(
+                value, limits::lowest(), limits::max());
+        }
+        return static_cast<Value>(value);
+    } else if constexpr (std::integral<source_type>) {
+        if (std::cmp_less(value, limits::lowest())) return limits::lowest();
+        if (std::cmp_greater(value, limits::max())) return limits::max();
+        return static_cast<Value>(value);
+    } else {
+        if (std::isnan(value)) return Value{};
+        if (value <= static_cast<source_type>(limits::lowest())) return limits::lowest();
+        if (value >= static_cast<source_type>(limits::max())) return limits::max();
+        return static_cast<Value>(value);
+    }
+}
+
 /**
  * @class config_item
  * @brief Configuration item.
- * @details Maps an arithmetic value to a named setting.
- * @tparam Values One or more arithmetic types, requried to be distinct.
+ * @details Maps an arithmetic value or an enumerator to a named setting. When
+ *     instantiated with a single value type, the value is stored as is instead of in a
+ *     variant, so that accessing it does not require any dispatching. Keeps track of
+ *     whether the value changed since the item was last loaded or saved, and counts how
+ *     often it changed. Enumerators are represented as strings by their names.
+ * @tparam Values One or more arithmetic or scoped enumeration types, requried to be
+ *     distinct.
  */
-template<cc::arithmetic... Values>
+template<cc::item_value... Values>
     requires cc::distinct<Values...>
 class config_item {
+    /**
+     * @brief Whether the value type is fixed to a single type.
+     */
+    static constexpr auto fixed = sizeof...(Values) == 1;
+
 public:
+    /**
+     * @typedef value_type
+     * @brief Type of the stored value; a variant unless the value type is fixed.
+     */
+    using value_type = std::conditional_t<fixed,
+        std::tuple_element_t<0, std::tuple<Values...>>, std::variant<Values...>>;
+
     /**
      * @brief Default constructs a configuration item.
      */
@@ -53,34 +288,50 @@ public:
 
     /**
      * @brief Constructs a configuration item with the given name and optional value.
+     * @details Not explicit, since designated initializers copy-list-initialize their
+     *     members, see config::defaults.
      * @tparam Value Value-type of the value to be stored.
-     * @param[in] name Name of the configuration item.
+     * @param[in] name Name of the configuration item, see operator""_name.
      * @param[in] value Initial value of the configuration item. Value-initializes the
      *     first value-type by default.
      */
     template<cc::convertible_to_any<Values...> Value>
-    constexpr explicit config_item(std::string name, Value value = {}):
-        name_{std::move(name)},
-        value_{value}
+    constexpr config_item(item_name name, Value value = {}):
+        name_{name},
+        value_(value)
     {}
 
+    config_item(config_item const&) = default;
+
+    /**
+     * @brief Assigns the name, value, and dirty state of another configuration item.
+     * @details Keeps counting its own revisions rather than taking over those of the
+     *     other item, so that the revision changes whenever the assignment changes the
+     *     name or the value, see revision.
+     * @param[in] other Configuration item to assign.
+     */
+    constexpr auto operator=(config_item const& other) noexcept -> config_item& {
+        if (*this != other) ++revision_;
+        name_ = other.name_;
+        value_ = other.value_;
+        dirty_ = other.dirty_;
+        return *this;
+    }
+
     /**
      * @brief Returns the name of the configuration item.
      */
     [[nodiscard]]
-    constexpr auto name() const noexcept -> std::string const&
-    { return name_; }
+    constexpr auto name() const noexcept -> std::string_view
+    { return name_.name; }
 
     /**
      * @brief Returns the tag name of the configuraiton item.
-     * @details Makes a copy of the name and simply replaces any space with a hyphen.
+     * @details Equals the name with any space replaced by a hyphen.
      */
     [[nodiscard]]
-    constexpr auto tagname() const noexcept -> std::string {
-        auto tag = std::string{name_};
-        std::ranges::replace(tag, ' ', '-');
-        return tag;
-    }
+    constexpr auto tagname() const noexcept -> std::string_view
+    { return name_.tag; }
 
     /**
      * @brief Returns the stored value converted to a string.
@@ -88,8 +339,23 @@ public:
      */
     template<std::same_as<std::string> String>
     [[nodiscard]]
-    constexpr auto to() const -> String
-    { return std::visit([](auto value) { return std::format("{}", value); }, value_); }
+    constexpr auto to() const -> String {
+        auto buffer = std::array<char, max_value_chars>{};
+        return String{format_to(buffer)};
+    }
+
+    /**
+     * @brief Writes the stored value as a string into the given buffer, without
+     *     allocating.
+     * @details Boolean values are written as "true" or "false", and floating point
+     *     values in their shortest round-trip representation.
+     * @param[out] buffer Buffer to write into, see max_value_chars.
+     * @return View of the written characters within the buffer, or an empty view when
+     *     the buffer is too small.
+     */
+    [[nodiscard]]
+    constexpr auto format_to(std::span<char> buffer) const noexcept -> std::string_view
+    { return visit([buffer](auto value) { return format_value(value, buffer); }, value_); }
 
     /**
      * @brief Returns the stored value.
@@ -98,21 +364,32 @@ public:
      */
     template<cc::same_as_any<Values...> Value>
     [[nodiscard]]
-    constexpr auto to() const -> Value
-    { return std::get<Value>(value_); }
+    constexpr auto to() const -> Value {
+        if constexpr (fixed) return value_;
+        else return std::get<Value>(value_);
+    }
 
     /**
      * @brief Sets a new value to a configuration item, represented as a string.
-     * @details Conversion to a boolean value will only result to true when the given
-     *     string matches "1" or "true".
+     * @details The value is left unchanged when the string is not valid, see
+     *     parse_value.
      * @param[in] value String that represents an arithmetic value to set.
      */
-    constexpr auto set(std::string_view value) noexcept -> void {
-         std::visit(util::visitor{
-            [value](bool& value_ref) { value_ref = (value == "1" or value == "true"); },
-            [value](auto& value_ref)
-            { std::from_chars(value.data(), value.data() + value.size(), value_ref); }
-        }, value_);
+    constexpr auto set(std::string_view value) noexcept -> void
+    { static_cast<void>(try_set(value)); }
+
+    /**
+     * @brief Sets a new value to a configuration item, represented as a string, and
+     *     tells whether the string was valid, see parse_value.
+     * @param[in] value String that represents an arithmetic value to set.
+     */
+    [[nodiscard]]
+    constexpr auto try_set(std::string_view value) noexcept -> parse_status {
+        auto const previous = value_;
+        auto const status = visit(
+            [value](auto& value_ref) { return parse_value(value, value_ref); }, value_);
+        changed(previous);
+        return status;
     }
 
     /**
@@ -120,8 +397,33 @@ public:
      * @param[in] value Arithmetic value to set, required to be convertible to one of the
      *     instantiated value types.
      */
-    constexpr auto set(cc::convertible_to_any<Values...> auto value) noexcept -> void
-    { value_ = value; }
+    constexpr auto set(cc::convertible_to_any<Values...> auto value) noexcept -> void {
+        auto const previous = value_;
+        value_ = static_cast<value_type>(value);
+        changed(previous);
+    }
+
+    /**
+     * @brief Returns whether the value changed since the item was last loaded or saved.
+     */
+    [[nodiscard]]
+    constexpr auto dirty() const noexcept -> bool
+    { return dirty_; }
+
+    /**
+     * @brief Marks the value as loaded or saved.
+     */
+    constexpr auto clean() noexcept -> void
+    { dirty_ = false; }
+
+    /**
+     * @brief Returns the revision number of the value.
+     * @details Changes whenever the value changes, including through assignment, e.g.
+     *     to tell whether a cached representation of the value is outdated.
+     */
+    [[nodiscard]]
+    constexpr auto revision() const noexcept -> uint32
+    { return revision_; }
 
     /**
      * @brief Contextually converts a configuration item to its stored boolean value.
@@ -129,7 +431,7 @@ public:
     [[nodiscard]]
     constexpr explicit operator bool() const noexcept
         requires cc::same_as_any<bool, Values...>
-    { return std::get<bool>(value_); }
+    { return to<bool>(); }
 
     /**
      * @brief Implicitly converts a configuration item to its stored value.
@@ -139,17 +441,43 @@ public:
     template<cc::convertible_to_any<Values...> Value>
     [[nodiscard]]
     constexpr operator Value() const noexcept
-    { return std::visit([](auto value) { return static_cast<Value>(value); }, value_); }
+    { return visit([](auto value) { return static_cast<Value>(value); }, value_); }
 
     /**
-     * @brief Compares two objects for equality.
+     * @brief Configuration items are considered to be equal when their names and values
+     *     match, regardless of whether they are dirty or of their revisions.
      */
     [[nodiscard]]
-    friend auto operator==(config_item const&, config_item const&) -> bool = default;
+    friend constexpr auto operator==(
+        config_item const& lhs, config_item const& rhs) noexcept -> bool
+    { return lhs.name_ == rhs.name_ and lhs.value_ == rhs.value_; }
 
 private:
-    std::string name_;              /**< Name of the setting. */
-    std::variant<Values...> value_; /**< Arithmetic value to store. */
+    /**
+     * @brief Invokes a callable with the given stored value.
+     * @details Dispatches on the active type only when the value type is not fixed.
+     * @param[in] function Callable to invoke, required to accept any of the value types.
+     * @param[in] value Stored value to invoke the callable with.
+     */
+    static constexpr auto visit(auto&& function, auto& value) -> decltype(auto) {
+        if constexpr (fixed) return std::invoke(function, value);
+        else return std::visit(std::forward<decltype(function)>(function), value);
+    }
+
+    /**
+     * @brief Marks the value as changed if it differs from the given previous value.
+     * @param[in] previous Value before it was set.
+     */
+    constexpr auto changed(value_type const& previous) noexcept -> void {
+        if (value_ == previous) return;
+        dirty_ = true;
+        ++revision_;
+    }
+
+    item_name name_;     /**< Name of the setting. */
+    value_type value_{}; /**< Value to store. */
+    uint32 revision_{};  /**< Number of times the value changed. */
+    bool dirty_{};       /**< Value changed since it was last loaded or saved. */
 };
 
 /**
@@ -159,6 +487,217 @@ private:
  */
 using cfgitem = config_item<bool, uint8, int, double>;
 
+/**
+ * @brief Configuration items that contain an arithmetic value of a fixed type.
+ * @{
+ */
+using boolitem   = config_item<bool>;
+using uint8item  = config_item<uint8>;
+using intitem    = config_item<int>;
+using doubleitem = config_item<double>;
+/** @} */
+
+/**
+ * @typedef formatitem
+ * @brief Configuration item that contains an image color format, represented as a
+ *     string by the name of its enumerator.
+ */
+using formatitem = config_item<cam::format>;
+
+static_assert(not refl::enum_names_v<cam::format>.empty(),
+    "color formats are required to be numbered from zero, see refl::enum_names_v");
+
+/**
+ * @brief Checks if the given type is a configuration item.
+ * @tparam T Type to check.
+ * @{
+ */
+template<typename T>
+struct is_item
+    : std::false_type {};
+
+template<cc::item_value... Values>
+struct is_item<config_item<Values...>>
+    : std::true_type {};
+/** @} */
+
+/**
+ * @typedef value_t
+ * @brief Value-type of a configuration item.
+ * @tparam Item Configuration item type, possibly cv- or reference-qualified.
+ */
+template<typename Item>
+using value_t = typename std::remove_cvref_t<Item>::value_type;
+
+/**
+ * @class item_ref
+ * @brief Non-owning reference to a configuration item of any fixed value type.
+ * @details Makes configuration items of different value types usable through a single
+ *     type, e.g. to add all of them to a single menu. Copies refer to the same item.
+ */
+class item_ref {
+public:
+    /**
+     * @brief Marks the type as a handle, see cc::configurable_handle.
+     */
+    static constexpr auto is_handle = true;
+
+    /**
+     * @brief Default constructs a reference that does not refer to any item.
+     */
+    item_ref() = default;
+
+    /**
+     * @brief Constructs a reference to the given configuration item.
+     * @tparam Value Value-type of the configuration item.
+     * @param[in] item Configuration item to refer to.
+     */
+    template<cc::item_value Value>
+    constexpr item_ref(config_item<Value>& item) noexcept:
+        item_{std::addressof(item)},
+        ops_{std::addressof(ops_v<Value>)}
+    {}
+
+    /**
+     * @brief Returns the name of the referred configuration item.
+     */
+    [[nodiscard]]
+    auto name() const noexcept -> std::string_view
+    { return ops_->name(item_); }
+
+    /**
+     * @brief Returns the tag name of the referred configuration item.
+     */
+    [[nodiscard]]
+    auto tagname() const noexcept -> std::string_view
+    { return ops_->tagname(item_); }
+
+    /**
+     * @brief Returns the value of the referred configuration item converted to a string.
+     * @tparam String Conversion-type, required to be a std::string.
+     */
+    template<std::same_as<std::string> String>
+    [[nodiscard]]
+    auto to() const -> String {
+        auto buffer = std::array<char, max_value_chars>{};
+        return String{format_to(buffer)};
+    }
+
+    /**
+     * @brief Writes the value of the referred configuration item as a string into the
+     *     given buffer, without allocating.
+     * @param[out] buffer Buffer to write into, see max_value_chars.
+     * @return View of the written characters within the buffer, or an empty view when
+     *     the buffer is too small.
+     */
+    [[nodiscard]]
+    auto format_to(std::span<char> buffer) const noexcept -> std::string_view
+    { return ops_->format_to(item_, buffer); }
+
+    /**
+     * @brief Sets a new value to the referred configuration item, represented as a string.
+     * @param[in] value String that represents an arithmetic value to set.
+     */
+    auto set(std::string_view value) const noexcept -> void
+    { static_cast<void>(ops_->set_string(item_, value)); }
+
+    /**
+     * @brief Sets a new value to the referred configuration item, represented as a
+     *     string, and tells whether the string was valid, see parse_value.
+     * @param[in] value String that represents an arithmetic value to set.
+     */
+    [[nodiscard]]
+    auto try_set(std::string_view value) const noexcept -> parse_status
+    { return ops_->set_string(item_, value); }
+
+    /**
+     * @brief Sets a new value to the referred configuration item.
+     * @details Passes the value on as the widest type of its kind, so that it is clamped
+     *     to the fixed value type as is, see clamp_value.
+     * @param[in] value Arithmetic value to set, clamped to the fixed value type. An
+     *     enumerator is set by its underlying value, which is ignored when it does not
+     *     exactly fit the underlying type or has no enumerator.
+     */
+    auto set(cc::arithmetic auto value) const noexcept -> void {
+        using value_type = decltype(value);
+        if constexpr (std::floating_point<value_type>) ops_->set_floating(item_, value);
+        else if constexpr (std::signed_integral<value_type>) ops_->set_signed(item_, value);
+        else ops_->set_unsigned(item_, value);
+    }
+
+    /**
+     * @brief Returns the revision number of the referred configuration item.
+     */
+    [[nodiscard]]
+    auto revision() const noexcept -> uint32
+    { return ops_->revision(item_); }
+
+    /**
+     * @brief References are considered to be equal when they refer to the same item.
+     */
+    [[nodiscard]]
+    friend constexpr auto operator==(item_ref const& lhs, item_ref const& rhs) noexcept -> bool
+    { return lhs.item_ == rhs.item_; }
+
+private:
+    /**
+     * @struct operations
+     * @brief Operations on a configuration item of a particular value type.
+     */
+    struct operations {
+        std::string_view (*name)(void const*) noexcept;       /**< Returns the name. */
+        std::string_view (*tagname)(void const*) noexcept;    /**< Returns the tag name. */
+        std::string_view (*format_to)(void const*, std::span<char>) noexcept;
+                                                              /**< Writes as a string. */
+        parse_status (*set_string)(void*, std::string_view) noexcept;
+                                                              /**< Sets from a string. */
+        void (*set_signed)(void*, std::intmax_t) noexcept;    /**< Sets from an int. */
+        void (*set_unsigned)(void*, std::uintmax_t) noexcept; /**< Sets from a uint. */
+        void (*set_floating)(void*, long double) noexcept;    /**< Sets from a float. */
+        uint32 (*revision)(void const*) noexcept;             /**< Returns the revision. */
+    };
+
+    /**
+     * @var ops_v
+     * @brief Operations on a configuration item with the given value type.
+     * @tparam Value Value-type of the configuration item.
+     */
+    template<cc::item_value Value>
+    static constexpr auto ops_v = [] {
+        using item_type = config_item<Value>;
+        constexpr auto set_value = [](void* item, cc::arithmetic auto value) noexcept {
+            if constexpr (cc::scoped_enum<Value>) {
+                using underlying_type = std::underlying_type_t<Value>;
+                auto const underlying = clamp_value<underlying_type>(value);
+                if (clamp_value<decltype(value)>(underlying) != value) return;
+                auto const enumerator = static_cast<Value>(underlying);
+                if (refl::enum_name(enumerator).empty()) return;
+                static_cast<item_type*>(item)->set(enumerator);
+            } else {
+                static_cast<item_type*>(item)->set(clamp_value<Value>(value));
+            }
+        };
+        return operations{
+            .name = [](void const* item) noexcept
+            { return static_cast<item_type const*>(item)->name(); },
+            .tagname = [](void const* item) noexcept
+            { return static_cast<item_type const*>(item)->tagname(); },
+            .format_to = [](void const* item, std::span<char> buffer) noexcept
+            { return static_cast<item_type const*>(item)->format_to(buffer); },
+            .set_string = [](void* item, std::string_view value) noexcept
+            { return static_cast<item_type*>(item)->try_set(value); },
+            .set_signed = set_value,
+            .set_unsigned = set_value,
+            .set_floating = set_value,
+            .revision = [](void const* item) noexcept
+            { return static_cast<item_type const*>(item)->revision(); }
+        };
+    }();
+
+    void* item_{};            /**< Referred configuration item. */
+    operations const* ops_{}; /**< Operations on the referred configuration item. */
+};
+
 /**
  * @struct xmlcfg
  * @brief XML related configuration.
@@ -170,7 +709,6 @@ struct xmlcfg {
     [[nodiscard]]
     friend auto operator==(xmlcfg const&, xmlcfg const&) -> bool = default;
 
-    ofxXmlSettings file;  /**< XML file. */
     std::string filename; /**< Name of the XML file. */
     std::string tagname;  /**< Top-level tag name. */
 };
@@ -186,9 +724,9 @@ struct screencfg {
     [[nodiscard]]
     friend auto operator==(screencfg const&, screencfg const&) -> bool = default;
 
-    cfgitem width;  /**< Width of the application screen. */
-    cfgitem height; /**< Height of the application screen. */
-    cfgitem rate;   /**< Frame rate of the application screen. */
+    intitem width;  /**< Width of the application screen. */
+    intitem height; /**< Height of the application screen. */
+    intitem rate;   /**< Frame rate of the application screen. */
 };
 
 /**
@@ -202,9 +740,9 @@ struct pidcfg {
     [[nodiscard]]
     friend auto operator==(pidcfg const&, pidcfg const&) -> bool = default;
 
-    cfgitem kp; /**< Proportional gain. */
-    cfgitem ki; /**< Integral gain. */
-    cfgitem kd; /**< Derivative gain. */
+    doubleitem kp; /**< Proportional gain. */
+    doubleitem ki; /**< Integral gain. */
+    doubleitem kd; /**< Derivative gain. */
 };
 
 /**
@@ -218,9 +756,9 @@ struct serialcfg {
     [[nodiscard]]
     friend auto operator==(serialcfg const&, serialcfg const&) -> bool = default;
 
-    cfgitem enabled;  /**< Enables a serial connection. */
-    cfgitem deviceid; /**< Device ID of the serial device. */
-    cfgitem baudrate; /**< Baudrate of the serial connection. */
+    boolitem enabled; /**< Enables a serial connection. */
+    intitem deviceid; /**< Device ID of the serial device. */
+    intitem baudrate; /**< Baudrate of the serial connection. */
 };
 
 /**
@@ -234,8 +772,8 @@ struct rangecfg {
     [[nodiscard]]
     friend auto operator==(rangecfg const&, rangecfg const&) -> bool = default;
 
-    cfgitem min; /**< Minimum range value. */
-    cfgitem max; /**< Maximum range value. */
+    intitem min; /**< Minimum range value. */
+    intitem max; /**< Maximum range value. */
 };
 
 /**
@@ -249,9 +787,9 @@ struct visioncfg {
     [[nodiscard]]
     friend auto operator==(visioncfg const&, visioncfg const&) -> bool = default;
 
-    cfgitem displaydebug; /**< Draws debug visualization lines. */
-    cfgitem trackball;    /**< Enables tracking of the ball. */
-    rangecfg ballradius;  /**< Radius of the ball. */
+    boolitem displaydebug; /**< Draws debug visualization lines. */
+    boolitem trackball;    /**< Enables tracking of the ball. */
+    rangecfg ballradius;   /**< Radius of the ball. */
 };
 
 /**
@@ -273,9 +811,9 @@ struct framecfg {
     [[nodiscard]]
     friend auto operator==(framecfg const&, framecfg const&) -> bool = default;
 
-    cfgitem width;  /**< Width of the camera frame. */
-    cfgitem height; /**< Height of the camera frame. */
-    cfgitem rate;   /**< Frame rate of the camera. */
+    intitem width;  /**< Width of the camera frame. */
+    intitem height; /**< Height of the camera frame. */
+    intitem rate;   /**< Frame rate of the camera. */
 };
 
 /**
@@ -289,10 +827,10 @@ struct balancecfg {
     [[nodiscard]]
     friend auto operator==(balancecfg const&, balancecfg const&) -> bool = default;
 
-    cfgitem red;       /**< Red color balance. */
-    cfgitem green;     /**< Green color balance. */
-    cfgitem blue;      /**< Blue color balance. */
-    cfgitem autowhite; /**< Enables automatic white color balancing. */
+    uint8item red;      /**< Red color balance. */
+    uint8item green;    /**< Green color balance. */
+    uint8item blue;     /**< Blue color balance. */
+    boolitem autowhite; /**< Enables automatic white color balancing. */
 };
 
 /**
@@ -306,136 +844,650 @@ struct camcfg {
     [[nodiscard]]
     friend auto operator==(camcfg const&, camcfg const&) -> bool = default;
 
-    framecfg frame;     /**< Camera frame configuration. */
-    balancecfg balance; /**< Color balance configuration. */
-    cfgitem format;     /**< Image color format. */
-    cfgitem exposure;   /**< Image exposure. */
-    cfgitem sharpness;  /**< Image sharpness. */
-    cfgitem contrast;   /**< Image contrast. */
-    cfgitem brightness; /**< Image brightness. */
-    cfgitem hue;        /**< Image hue. */
-    cfgitem gain;       /**< Image gain. */
-    cfgitem autogain;   /**< Enables automatic image gain. */
+    framecfg frame;       /**< Camera frame configuration. */
+    balancecfg balance;   /**< Color balance configuration. */
+    formatitem format;    /**< Image color format. */
+    uint8item exposure;   /**< Image exposure. */
+    uint8item sharpness;  /**< Image sharpness. */
+    uint8item contrast;   /**< Image contrast. */
+    uint8item brightness; /**< Image brightness. */
+    uint8item hue;        /**< Image hue. */
+    uint8item gain;       /**< Image gain. */
+    boolitem autogain;    /**< Enables automatic image gain. */
 };
 
+/**
+ * @struct screenview
+ * @brief Plain values of the application screen related configuration.
+ */
+struct screenview {
+    int width;  /**< Width of the application screen. */
+    int height; /**< Height of the application screen. */
+    int rate;   /**< Frame rate of the application screen. */
+};
+
+/**
+ * @struct pidview
+ * @brief Plain values of the PID controller related configuration.
+ */
+struct pidview {
+    double kp; /**< Proportional gain. */
+    double ki; /**< Integral gain. */
+    double kd; /**< Derivative gain. */
+};
+
+/**
+ * @struct serialview
+ * @brief Plain values of the serial connection related configuration.
+ */
+struct serialview {
+    int deviceid; /**< Device ID of the serial device. */
+    int baudrate; /**< Baudrate of the serial connection. */
+    bool enabled; /**< Enables a serial connection. */
+};
+
+/**
+ * @struct rangeview
+ * @brief Plain values of a range related configuration.
+ */
+struct rangeview {
+    int min; /**< Minimum range value. */
+    int max; /**< Maximum range value. */
+};
+
+/**
+ * @struct visionview
+ * @brief Plain values of the computer vision related configuration.
+ */
+struct visionview {
+    rangeview ballradius; /**< Radius of the ball. */
+    bool displaydebug;    /**< Draws debug visualization lines. */
+    bool trackball;       /**< Enables tracking of the ball. */
+};
+
+/**
+ * @struct frameview
+ * @brief Plain values of the camera frame related configuration.
+ */
+struct frameview {
+    int width;  /**< Width of the camera frame. */
+    int height; /**< Height of the camera frame. */
+    int rate;   /**< Frame rate of the camera. */
+};
+
+/**
+ * @struct balanceview
+ * @brief Plain values of the color balance related configuration.
+ */
+struct balanceview {
+    uint8 red;      /**< Red color balance. */
+    uint8 green;    /**< Green color balance. */
+    uint8 blue;     /**< Blue color balance. */
+    bool autowhite; /**< Enables automatic white color balancing. */
+};
+
+/**
+ * @struct camview
+ * @brief Plain values of the camera related configuration.
+ */
+struct camview {
+    frameview frame;     /**< Camera frame configuration. */
+    cam::format format;  /**< Image color format. */
+    balanceview balance; /**< Color balance configuration. */
+    uint8 exposure;      /**< Image exposure. */
+    uint8 sharpness;     /**< Image sharpness. */
+    uint8 contrast;      /**< Image contrast. */
+    uint8 brightness;    /**< Image brightness. */
+    uint8 hue;           /**< Image hue. */
+    uint8 gain;          /**< Image gain. */
+    bool autogain;       /**< Enables automatic image gain. */
+};
+
+/**
+ * @struct hotview
+ * @brief Plain values of the configuration settings, meant to be read on hot paths.
+ * @details Stores every setting as its native type, without a name, so that reading a
+ *     setting is a plain load. The members are ordered to pack the settings into two
+ *     cache lines, with the PID controller and computer vision settings in the first.
+ *     Refresh a view whenever the configuration changes, see config::view. Every
+ *     configuration item is required to have a member, which is checked at compile
+ *     time by counting the plain values.
+ */
+struct alignas(64) hotview {
+    pidview pid;       /**< PID controller configuration. */
+    visionview vision; /**< Computer vision configuration. */
+    serialview serial; /**< Serial connection configuration. */
+    screenview screen; /**< Application screen configuration. */
+    camview cam;       /**< Camera configuration. */
+};
+
+static_assert(sizeof(hotview) == 128);
+static_assert(std::is_trivially_copyable_v<hotview>);
+
 /**
  * @struct config
  * @brief Configuration settings of this application.
  */
 struct config {
+private:
+    /**
+     * @brief Returns a tuple of references to all the configuration settings.
+     * @details Enumerates the configuration items of the nested configurations in order
+     *     of declaration, so that an added item is included without further ado.
+     * @param[in] self Configuration settings, possibly const-qualified.
+     */
+    [[nodiscard]]
+    static constexpr auto tie(auto& self) noexcept
+    { return refl::flatten<is_item>(self); }
+
+    /**
+     * @struct binheader
+     * @brief Header of the binary cache of the configuration settings.
+     * @details Followed by the values of all settings, in the order of as_tuple, each
+     *     stored as the bytes of its value type.
+     */
+    struct binheader {
+        static constexpr auto magic_v = uint32{0x4247'4643}; /**< Reads "CFGB". */
+        static constexpr auto version_v = uint32{1};         /**< Format version. */
+
+        uint32 magic;    /**< Identifies the file as a binary cache. */
+        uint32 version;  /**< Version of the binary format. */
+        uint64 schema;   /**< Hash of the tag names and value types of the settings. */
+        int64 mtime;     /**< Last write time of the XML file the cache was made from. */
+        uint64 xmlsize;  /**< Size of the XML file the cache was made from. */
+        uint64 xmlhash;  /**< Hash of the XML file the cache was made from. */
+        uint64 checksum; /**< Hash of the values that follow the header. */
+    };
+
+    /**
+     * @brief Returns a hash of the tag names and value types of all settings.
+     * @details Differs whenever a setting is added, removed, renamed, or retyped.
+     */
+    [[nodiscard]]
+    auto schema() const noexcept -> uint64 {
+        return std::apply([](auto const&... items) {
+            auto hash = util::fnv1a({});
+            auto const add = [&hash](auto const& item) {
+                using value_type = value_t<decltype(item)>;
+                char const type[] = {
+                    static_cast<char>(sizeof(value_type)),
+                    static_cast<char>(std::is_floating_point_v<value_type>),
+                    static_cast<char>(std::is_signed_v<value_type>)};
+                hash = util::fnv1a(item.tagname(), hash);
+                hash = util::fnv1a({type, sizeof(type)}, hash);
+            };
+            (add(items), ...);
+            return hash;
+        }, tie(*this));
+    }
+
+    /**
+     * @brief Returns the values of all settings, as stored in the binary cache.
+     */
+    [[nodiscard]]
+    auto tobin() const -> std::string {
+        auto values = std::string{};
+        std::apply([&values](auto const&... items) {
+            auto const append = [&values](auto const& item) {
+                using value_type = value_t<decltype(item)>;
+                auto const value = item.template to<value_type>();
+                values.append(reinterpret_cast<char const*>(&value), sizeof(value));
+            };
+            (append(items), ...);
+        }, tie(*this));
+        return values;
+    }
+
+    /**
+     * @brief Sets the values of all settings from the binary cache.
+     * @param[in] values Values that follow the header of the binary cache.
+     * @return If the values matched the size of all settings, returns true. Otherwise,
+     *     returns false, leaving all settings unchanged.
+     */
+    auto frombin(std::string_view values) noexcept -> bool {
+        return std::apply([values](auto&... items) mutable {
+            if (values.size() != (sizeof(value_t<decltype(items)>) + ...)) return false;
+            auto const read = [&values](auto& item) {
+                auto value = value_t<decltype(item)>{};
+                std::memcpy(&value, values.data(), sizeof(value));
+                values.remove_prefix(sizeof(value));
+                item.set(value);
+                item.clean();
+            };
+            (read(items), ...);
+            return true;
+        }, tie(*this));
+    }
+
+    /**
+     * @brief Parses the configuration settings from an XML document.
+     * @details Every value that is not valid for its configuration item is reported,
+     *     see parse_value, without interrupting the parse.
+     * @tparam Report Callable type, required to be invocable with the tag name, the
+     *     value, and the parse status.
+     * @param[in] document XML document to parse.
+     * @param[in] report Callable to invoke for every invalid value.
+     * @return Number of invalid values.
+     */
+    template<std::invocable<std::string_view, std::string_view, parse_status> Report>
+    auto fromxml(std::string_view document, Report&& report) -> std::size_t {
+        auto invalid = std::size_t{};
+        xml::parse(document, [this, &report, &invalid](auto path, auto value) {
+            if (path.size() != 2 or path.front() != xml.tagname) return;
+            visit(path.back(), [&](auto& item) {
+                auto const status = item.try_set(value);
+                item.clean();
+                if (status == parse_status::ok) return;
+                ++invalid;
+                std::invoke(report, path.back(), value, status);
+            });
+        });
+        return invalid;
+    }
+
+    /**
+     * @brief Parses the configuration settings from an XML document, ignoring invalid
+     *     values.
+     * @param[in] document XML document to parse.
+     */
+    auto fromxml(std::string_view document) -> void
+    { fromxml(document, [](auto, auto, auto) {}); }
+
+    /**
+     * @brief Returns the tag names of the default configuration settings, in the order
+     *     of as_tuple.
+     */
+    [[nodiscard]]
+    static consteval auto tagnames() noexcept {
+        auto const settings = defaults();
+        return std::apply([](auto const&... items) {
+            return std::array<std::string_view, sizeof...(items)>{items.tagname()...};
+        }, tie(settings));
+    }
+
+    /**
+     * @brief Invokes a callable with the configuration item with the given tag name.
+     * @details Finds the item by its index, see indexof, and dispatches to it through
+     *     a table, so that neither takes more than constant time.
+     * @tparam Function Callable type, required to accept any configuration item.
+     * @param[in] tag Tag name of the configuration item.
+     * @param[in] function Callable to invoke.
+     * @return If a configuration item was found, returns true. Otherwise, returns false.
+     */
+    template<typename Function>
+    auto visit(std::string_view tag, Function&& function) -> bool {
+        using items_type = decltype(tie(std::declval<config&>()));
+        static constexpr auto table = []<std::size_t... Indices>(
+            std::index_sequence<Indices...>
+        ) {
+            return std::array<void (*)(config&, Function&), sizeof...(Indices)>{
+                [](config& self, Function& function)
+                { std::invoke(function, std::get<Indices>(tie(self))); }...};
+        }(std::make_index_sequence<std::tuple_size_v<items_type>>{});
+
+        auto const index = indexof(tag);
+        if (index == table.size()) return false;
+        table[index](*this, function);
+        return true;
+    }
+
+public:
     /**
      * @brief Returns the default configuration settings.
      */
     [[nodiscard]]
-    static auto defaults() noexcept -> config {
+    static constexpr auto defaults() noexcept -> config {
         return {
             .xml{
                 .filename{"settings.xml"},
                 .tagname{"settings"}},
             .screen{
-                .width{"screen width", 800},
-                .height{"screen height", 600},
-                .rate{"screen rate", 60}},
+                .width{"screen width"_name, 800},
+                .height{"screen height"_name, 600},
+                .rate{"screen rate"_name, 60}},
             .serial{
-                .enabled{"serial enabled", true},
-                .deviceid{"device id", 0},
-                .baudrate{"baudrate", 115'200}},
+                .enabled{"serial enabled"_name, true},
+                .deviceid{"device id"_name, 0},
+                .baudrate{"baudrate"_name, 115'200}},
             .pid{
-                .kp{"proportional", 0.3},
-                .ki{"integral", 0.001},
-                .kd{"derivative", 5.0}},
+                .kp{"proportional"_name, 0.3},
+                .ki{"integral"_name, 0.001},
+                .kd{"derivative"_name, 5.0}},
             .vision{
-                .displaydebug{"display debug", true},
-                .trackball{"ball tracking", true},
+                .displaydebug{"display debug"_name, true},
+                .trackball{"ball tracking"_name, true},
                 .ballradius{
-                    .min{"min. ball radius", 5},
-                    .max{"max. ball radius", 75}}},
+                    .min{"min. ball radius"_name, 5},
+                    .max{"max. ball radius"_name, 75}}},
             .cam{
                 .frame{
-                    .width{"frame width", 640},
-                    .height{"frame height", 480},
-                    .rate{"frame rate", 60}},
+                    .width{"frame width"_name, 640},
+                    .height{"frame height"_name, 480},
+                    .rate{"frame rate"_name, 60}},
                 .balance{
-                    .red{"red balance", 128_u8},
-                    .green{"green balance", 128_u8},
-                    .blue{"blue balance", 128_u8},
-                    .autowhite{"auto white bal.", false}},
-                .format{"color format", static_cast<int>(cam::format::Gray)},
-                .exposure{"exposure", 20_u8},
-                .sharpness{"sharpness", 128_u8},
-                .contrast{"contrast", 128_u8},
-                .brightness{"brightness", 128_u8},
-                .hue{"hue", 128_u8},
-                .gain{"gain", 20_u8},
-                .autogain{"auto gain", false}}
+                    .red{"red balance"_name, 128_u8},
+                    .green{"green balance"_name, 128_u8},
+                    .blue{"blue balance"_name, 128_u8},
+                    .autowhite{"auto white bal."_name, false}},
+                .format{"color format"_name, cam::format::Gray},
+                .exposure{"exposure"_name, 20_u8},
+                .sharpness{"sharpness"_name, 128_u8},
+                .contrast{"contrast"_name, 128_u8},
+                .brightness{"brightness"_name, 128_u8},
+                .hue{"hue"_name, 128_u8},
+                .gain{"gain"_name, 20_u8},
+                .autogain{"auto gain"_name, false}}
         };
     }
 
     /**
      * @brief Returns a tuple of all the configuration settings.
-     * @note With static reflection, this helper function will become redundant.
-     */
-    [[nodiscard]]
-    constexpr auto as_tuple() noexcept {
-        return std::tie(
-            screen.width,
-            screen.height,
-            screen.rate,
-            serial.enabled,
-            serial.deviceid,
-            serial.baudrate,
-            pid.kp,
-            pid.ki,
-            pid.kd,
-            vision.displaydebug,
-            vision.trackball,
-            vision.ballradius.min,
-            vision.ballradius.max,
-            cam.frame.width,
-            cam.frame.height,
-            cam.frame.rate,
-            cam.balance.red,
-            cam.balance.blue,
-            cam.balance.green,
-            cam.balance.autowhite,
-            cam.format,
-            cam.exposure,
-            cam.sharpness,
-            cam.contrast,
-            cam.brightness,
-            cam.hue,
-            cam.gain,
-            cam.autogain
-        );
+     * @{
+     */
+    [[nodiscard]]
+    constexpr auto as_tuple() noexcept
+    { return tie(*this); }
+
+    [[nodiscard]]
+    constexpr auto as_tuple() const noexcept
+    { return tie(*this); }
+    /** @} */
+
+    /**
+     * @brief Returns the number of configuration settings.
+     */
+    [[nodiscard]]
+    static constexpr auto size() noexcept -> std::size_t
+    { return std::tuple_size_v<decltype(tie(std::declval<config&>()))>; }
+
+    /**
+     * @brief Returns the configuration setting with the given index, in the order of
+     *     as_tuple.
+     * @tparam Index Index of the configuration setting.
+     * @{
+     */
+    template<std::size_t Index>
+        requires (Index < size())
+    [[nodiscard]]
+    constexpr auto get() noexcept -> auto&
+    { return std::get<Index>(as_tuple()); }
+
+    template<std::size_t Index>
+        requires (Index < size())
+    [[nodiscard]]
+    constexpr auto get() const noexcept -> auto const&
+    { return std::get<Index>(as_tuple()); }
+    /** @} */
+
+    /**
+     * @brief Returns the configuration setting or nested configuration with the given
+     *     path.
+     * @details Resolves the path at compile time, see refl::get, so that the access
+     *     compiles to a plain member access. A path with a typo fails to compile.
+     * @tparam Path Names of the nested members, separated by dots, e.g. "pid.kp".
+     * @{
+     */
+    template<util::fixed_string Path>
+    [[nodiscard]]
+    constexpr auto get() noexcept -> auto&
+    { return refl::get<Path>(*this); }
+
+    template<util::fixed_string Path>
+    [[nodiscard]]
+    constexpr auto get() const noexcept -> auto const&
+    { return refl::get<Path>(*this); }
+    /** @} */
+
+    /**
+     * @brief Returns the index of the configuration setting with the given tag name, in
+     *     the order of as_tuple.
+     * @details Looks up the tag name by a perfect hash of the tag names of the default
+     *     settings, which is generated at compile time, see util::perfect_index.
+     * @param[in] tag Tag name of the configuration setting.
+     * @return If a setting was found, returns its index. Otherwise, returns the number of
+     *     settings.
+     */
+    [[nodiscard]]
+    static auto indexof(std::string_view tag) noexcept -> std::size_t {
+        static constexpr auto index = util::perfect_index{tagnames()};
+        return index.find(tag);
     }
 
     /**
-     * @brief Loads the configuration settings from an XML file.
+     * @brief Returns a reference to the configuration setting with the given index, in
+     *     the order of as_tuple.
+     * @details Looks up the setting in a table that is built at compile time, and
+     *     therefore takes constant time.
+     * @pre Ensure the index is less than the number of settings before calling this
+     *     function.
+     * @param[in] index Index of the configuration setting.
+     */
+    [[nodiscard]]
+    auto get(std::size_t index) noexcept -> item_ref {
+        static constexpr auto table = []<std::size_t... Indices>(
+            std::index_sequence<Indices...>
+        ) {
+            return std::array<item_ref (*)(config&) noexcept, sizeof...(Indices)>{
+                [](config& self) noexcept -> item_ref
+                { return self.get<Indices>(); }...};
+        }(std::make_index_sequence<size()>{});
+        return table[index](*this);
+    }
+
+    /**
+     * @brief Returns the plain values of the configuration settings.
+     * @details Intended to be called only when the configuration changes, after which
+     *     the result can be handed to the hot paths, e.g. through a publisher.
      */
-    auto loadxml() -> void {
-        xml.file.load(xml.filename);
-        xml.file.addTag(xml.tagname);
-        xml.file.pushTag(xml.tagname);
-        std::apply([this](auto&... items) {
-            ((items.set(xml.file.getValue(
-                items.tagname(), items.to<std::string>()))), ...);
+    [[nodiscard]]
+    auto view() const noexcept -> hotview {
+        return {
+            .pid{
+                .kp{pid.kp},
+                .ki{pid.ki},
+                .kd{pid.kd}},
+            .vision{
+                .ballradius{
+                    .min{vision.ballradius.min},
+                    .max{vision.ballradius.max}},
+                .displaydebug{vision.displaydebug},
+                .trackball{vision.trackball}},
+            .serial{
+                .deviceid{serial.deviceid},
+                .baudrate{serial.baudrate},
+                .enabled{serial.enabled}},
+            .screen{
+                .width{screen.width},
+                .height{screen.height},
+                .rate{screen.rate}},
+            .cam{
+                .frame{
+                    .width{cam.frame.width},
+                    .height{cam.frame.height},
+                    .rate{cam.frame.rate}},
+                .format{cam.format},
+                .balance{
+                    .red{cam.balance.red},
+                    .green{cam.balance.green},
+                    .blue{cam.balance.blue},
+                    .autowhite{cam.balance.autowhite}},
+                .exposure{cam.exposure},
+                .sharpness{cam.sharpness},
+                .contrast{cam.contrast},
+                .brightness{cam.brightness},
+                .hue{cam.hue},
+                .gain{cam.gain},
+                .autogain{cam.autogain}}
+        };
+    }
+
+    /**
+     * @brief Sets the configuration item with the given tag name.
+     * @param[in] tag Tag name of the configuration item to set.
+     * @param[in] value String that represents the value to set.
+     * @return If the value of a configuration item changed, returns true. Otherwise,
+     *     returns false.
+     */
+    auto set(std::string_view tag, std::string_view value) noexcept -> bool {
+        auto changed = false;
+        visit(tag, [value, &changed](auto& item) {
+            auto const previous = item;
+            item.set(value);
+            changed = item != previous;
+        });
+        return changed;
+    }
+
+    /**
+     * @brief Sets the configuration item with the given tag name to a value that was
+     *     read from the XML file, after which the item is no longer dirty.
+     * @details An item that is dirty is left as it is, so that reloading the file never
+     *     discards changes that are yet to be saved.
+     * @param[in] tag Tag name of the configuration item to set.
+     * @param[in] value String that represents the value to set.
+     * @return If the value of a configuration item changed, returns true. Otherwise,
+     *     returns false.
+     */
+    auto fromxml(std::string_view tag, std::string_view value) noexcept -> bool {
+        auto changed = false;
+        visit(tag, [value, &changed](auto& item) {
+            if (item.dirty()) return;
+            auto const previous = item;
+            item.set(value);
+            item.clean();
+            changed = item != previous;
+        });
+        return changed;
+    }
+
+    /**
+     * @brief Returns whether any setting changed since it was last loaded or saved.
+     */
+    [[nodiscard]]
+    auto dirty() const noexcept -> bool {
+        return std::apply([](auto const&... items) {
+            return (items.dirty() or ...);
         }, as_tuple());
-        xml.file.popTag();
-        xml.file.clear();
     }
 
     /**
-     * @brief Saves the configuration settings to an XML file.
+     * @brief Marks all settings as loaded or saved.
+     */
+    auto clean() noexcept -> void
+    { std::apply([](auto&... items) { (items.clean(), ...); }, as_tuple()); }
+
+    /**
+     * @brief Loads the configuration settings from an XML file.
+     * @details Reads the file once and streams through it, setting every configuration
+     *     item whose tag is found directly below the top-level tag. Settings that are
+     *     missing from the file retain their current value. Invalid values are counted
+     *     and reported in the same pass, see parse_value.
+     * @tparam Report Callable type, required to be invocable with the tag name, the
+     *     value, and the parse status.
+     * @param[in] report Optional callable to invoke for every invalid value.
+     * @return Number of invalid values.
+     * @{
+     */
+    template<std::invocable<std::string_view, std::string_view, parse_status> Report>
+    auto loadxml(Report&& report) -> std::size_t
+    { return fromxml(xml::read(ofToDataPath(xml.filename)), std::forward<Report>(report)); }
+
+    auto loadxml() -> std::size_t
+    { return loadxml([](auto, auto, auto) {}); }
+    /** @} */
+
+    /**
+     * @brief Loads the configuration settings, preferably from their binary cache.
+     * @details The binary cache is stored next to the XML file and is used as long as it
+     *     was made from the current XML file, which is assumed when the last write time
+     *     and size of the XML file still match, or otherwise verified by its hash. Only
+     *     when the cache is stale, corrupt, or missing, the XML file is parsed and the
+     *     cache is rewritten.
+     */
+    auto load() -> void {
+        auto const path = ofToDataPath(xml.filename);
+        auto const cachepath = path + ".bin";
+        auto mtime_error = std::error_code{};
+        auto size_error = std::error_code{};
+        auto const mtime = std::filesystem::last_write_time(path, mtime_error);
+        auto const xmlsize = std::filesystem::file_size(path, size_error);
+        if (mtime_error or size_error) return;
+
+        auto const cache = xml::read(cachepath);
+        auto header = binheader{};
+        auto values = std::string_view{};
+        if (cache.size() >= sizeof(header)) {
+            std::memcpy(&header, cache.data(), sizeof(header));
+            values = std::string_view{cache}.substr(sizeof(header));
+        }
+        auto const valid = header.magic == binheader::magic_v
+            and header.version == binheader::version_v
+            and header.schema == schema()
+            and header.checksum == util::fnv1a(values);
+
+        auto const fresh = valid
+            and header.mtime == mtime.time_since_epoch().count()
+            and header.xmlsize == xmlsize;
+        if (fresh and frombin(values)) return;
+
+        auto const document = xml::read(path);
+        auto const xmlhash = util::fnv1a(document);
+        if (not valid or header.xmlhash != xmlhash or not frombin(values)) fromxml(document);
+
+        auto const binary = tobin();
+        header = {
+            .magic = binheader::magic_v,
+            .version = binheader::version_v,
+            .schema = schema(),
+            .mtime = mtime.time_since_epoch().count(),
+            .xmlsize = xmlsize,
+            .xmlhash = xmlhash,
+            .checksum = util::fnv1a(binary)};
+        auto contents = std::string(reinterpret_cast<char const*>(&header), sizeof(header));
+        contents += binary;
+        xml::write(cachepath, contents);
+    }
+
+    /**
+     * @brief Saves the configuration settings to an XML file, if any setting changed or
+     *     the file does not exist yet.
+     * @details Writes a temporary file that replaces the XML file once it is complete,
+     *     so that the XML file is never left partially written.
      */
     auto savexml() -> void {
-        xml.file.addTag(xml.tagname);
-        xml.file.pushTag(xml.tagname);
-        std::apply([this](auto const&... items) {
-            (xml.file.setValue(items.tagname(), items.to<std::string>()), ...);
+        auto const path = ofToDataPath(xml.filename);
+        auto error = std::error_code{};
+        if (not dirty() and std::filesystem::exists(path, error)) return;
+        if (xml::write(path, toxml())) clean();
+    }
+
+    /**
+     * @brief Returns the configuration settings as an XML document.
+     */
+    [[nodiscard]]
+    auto toxml() const -> std::string {
+        auto document = std::string{};
+        toxml(document);
+        return document;
+    }
+
+    /**
+     * @brief Writes the configuration settings as an XML document into the given
+     *     string, replacing its contents.
+     * @details Reuses the storage of the string, so that writing the settings
+     *     repeatedly into the same string does not allocate.
+     * @param[out] document String to write the XML document into.
+     */
+    auto toxml(std::string& document) const -> void {
+        document.clear();
+        auto out = std::back_inserter(document);
+        std::format_to(out, "<{}>\n", xml.tagname);
+        std::apply([out](auto const&... items) mutable {
+            auto buffer = std::array<char, max_value_chars>{};
+            ((out = std::format_to(out, "    <{0}>{1}</{0}>\n",
+                items.tagname(), items.format_to(buffer))), ...);
         }, as_tuple());
-        xml.file.saveFile(xml.filename);
-        xml.file.popTag();
-        xml.file.clear();
+        std::format_to(out, "</{}>\n", xml.tagname);
     }
 
     /**
@@ -452,6 +1504,405 @@ struct config {
     camcfg cam;       /**< Camera configuration. */
 };
 
+static_assert(std::tuple_size_v<decltype(refl::flatten<std::is_scalar>(
+    std::declval<hotview&>()))> == config::size(),
+    "every configuration item is required to have a plain value in hotview");
+
+/**
+ * @class config_table
+ * @brief Configuration settings that are created at runtime.
+ * @details Scales to thousands of settings by storing the names, value types, values,
+ *     and states of the settings in separate arrays, indexed by setting. Settings are
+ *     referred to by handles that satisfy cc::configurable, and are looked up by their
+ *     tag names in constant time. Settings are never removed, so handles stay valid for
+ *     as long as the table lives.
+ */
+class config_table {
+public:
+    /**
+     * @class item
+     * @brief Handle to a setting of a configuration table.
+     */
+    class item {
+    public:
+        /**
+         * @brief Marks the type as a handle, see cc::configurable_handle.
+         */
+        static constexpr auto is_handle = true;
+
+        /**
+         * @brief Default constructs a handle that does not refer to any setting.
+         */
+        item() = default;
+
+        /**
+         * @brief Constructs a handle to the setting with the given index.
+         * @param[in] table Table that contains the setting.
+         * @param[in] index Index of the setting.
+         */
+        constexpr item(config_table& table, uint32 index) noexcept:
+            table_{std::addressof(table)},
+            index_{index}
+        {}
+
+        /**
+         * @brief Returns the name of the setting.
+         */
+        [[nodiscard]]
+        auto name() const noexcept -> std::string_view
+        { return table_->names_[index_]; }
+
+        /**
+         * @brief Returns the tag name of the setting.
+         */
+        [[nodiscard]]
+        auto tagname() const noexcept -> std::string_view
+        { return table_->tags_[index_]; }
+
+        /**
+         * @brief Returns the value of the setting converted to a string.
+         * @tparam String Conversion-type, required to be a std::string.
+         */
+        template<std::same_as<std::string> String>
+        [[nodiscard]]
+        auto to() const -> String {
+            auto buffer = std::array<char, max_value_chars>{};
+            return String{format_to(buffer)};
+        }
+
+        /**
+         * @brief Returns the value of the setting.
+         * @tparam Value Type of the value to retrieve, converted from the value type of
+         *     the setting.
+         */
+        template<cc::arithmetic Value>
+        [[nodiscard]]
+        auto to() const noexcept -> Value {
+            return table_->visit(index_,
+                [](auto value) { return static_cast<Value>(value); });
+        }
+
+        /**
+         * @brief Writes the value of the setting as a string into the given buffer,
+         *     without allocating, see format_value.
+         * @param[out] buffer Buffer to write into, see max_value_chars.
+         */
+        [[nodiscard]]
+        auto format_to(std::span<char> buffer) const noexcept -> std::string_view {
+            return table_->visit(index_,
+                [buffer](auto value) { return format_value(value, buffer); });
+        }
+
+        /**
+         * @brief Sets a new value to the setting, represented as a string.
+         * @param[in] value String that represents an arithmetic value to set.
+         */
+        auto set(std::string_view value) const noexcept -> void {
+            table_->update(index_,
+                [value](auto& value_ref) { parse_value(value, value_ref); });
+        }
+
+        /**
+         * @brief Sets a new value to the setting, represented as a string, and tells
+         *     whether the string was valid, see parse_value.
+         * @param[in] value String that represents an arithmetic value to set.
+         */
+        [[nodiscard]]
+        auto try_set(std::string_view value) const noexcept -> parse_status {
+            auto status = parse_status::ok;
+            table_->update(index_, [value, &status](auto& value_ref)
+            { status = parse_value(value, value_ref); });
+            return status;
+        }
+
+        /**
+         * @brief Sets a new value to the setting.
+         * @param[in] value Arithmetic value to set, clamped to the value type of the
+         *     setting, see clamp_value.
+         */
+        auto set(cc::arithmetic auto value) const noexcept -> void {
+            table_->update(index_, [value](auto& value_ref)
+            { value_ref = clamp_value<std::remove_cvref_t<decltype(value_ref)>>(value); });
+        }
+
+        /**
+         * @brief Returns whether the value changed since it was last loaded or saved.
+         */
+        [[nodiscard]]
+        auto dirty() const noexcept -> bool
+        { return table_->dirty_[index_] != 0; }
+
+        /**
+         * @brief Returns the revision number of the value.
+         */
+        [[nodiscard]]
+        auto revision() const noexcept -> uint32
+        { return table_->revisions_[index_]; }
+
+        /**
+         * @brief Handles are considered to be equal when they refer to the same setting.
+         */
+        [[nodiscard]]
+        friend auto operator==(item const&, item const&) -> bool = default;
+
+    private:
+        friend config_table;
+
+        config_table* table_{}; /**< Table that contains the setting. */
+        uint32 index_{};        /**< Index of the setting. */
+    };
+
+    /**
+     * @brief Constructs an empty table, stored in the given XML file.
+     * @param[in] xml XML related configuration, containing the file and tag names.
+     */
+    explicit config_table(xmlcfg xml):
+        xml_{std::move(xml)}
+    {}
+
+    config_table(config_table const&) = delete;
+    auto operator=(config_table const&) -> config_table& = delete;
+
+    /**
+     * @brief Adds a setting with the given name and initial value.
+     * @details Takes amortized constant time. The tag name of the setting equals its
+     *     name with any space replaced by a hyphen.
+     * @tparam Value Value-type of the setting; either bool, uint8, int, or double.
+     * @param[in] name Name of the setting.
+     * @param[in] value Initial value of the setting.
+     * @return Handle to the added setting, or to the existing setting with the same tag
+     *     name, which is left unchanged.
+     * @throw std::invalid_argument When the tag name is not a valid XML tag name, see
+     *     xml::valid_name.
+     */
+    template<cc::same_as_any<bool, uint8, int, double> Value>
+    auto add(std::string_view name, Value value) -> item {
+        auto tag = std::string{name};
+        std::ranges::replace(tag, ' ', '-');
+        if (not xml::valid_name(tag)) {
+            throw std::invalid_argument{"setting name is not a valid XML tag name"};
+        }
+        auto const index = static_cast<uint32>(names_.size());
+        auto const [entry, added] = index_.try_emplace(tag, index);
+        if (not added) return {*this, entry->second};
+
+        names_.emplace_back(name);
+        tags_.push_back(std::move(tag));
+        kinds_.push_back(kind_v<Value>);
+        values_.push_back(make_cell(value));
+        revisions_.push_back(0);
+        dirty_.push_back(0);
+        return {*this, index};
+    }
+
+    /**
+     * @brief Returns a handle to the setting with the given tag name, if any.
+     * @details Takes constant time on average, and does not allocate.
+     * @param[in] tag Tag name of the setting.
+     */
+    [[nodiscard]]
+    auto find(std::string_view tag) noexcept -> std::optional<item> {
+        auto const entry = index_.find(tag);
+        if (entry == index_.end()) return std::nullopt;
+        return item{*this, entry->second};
+    }
+
+    /**
+     * @brief Returns a handle to the setting with the given index, in order of addition.
+     * @pre Ensure the index is less than the number of settings before calling this
+     *     function.
+     * @param[in] index Index of the setting.
+     */
+    [[nodiscard]]
+    auto operator[](std::size_t index) noexcept -> item
+    { return {*this, static_cast<uint32>(index)}; }
+
+    /**
+     * @brief Returns the number of settings.
+     */
+    [[nodiscard]]
+    auto size() const noexcept -> std::size_t
+    { return names_.size(); }
+
+    /**
+     * @brief Returns whether any setting changed since it was last loaded or saved.
+     */
+    [[nodiscard]]
+    auto dirty() const noexcept -> bool
+    { return std::ranges::any_of(dirty_, [](auto dirty) { return dirty != 0; }); }
+
+    /**
+     * @brief Marks all settings as loaded or saved.
+     */
+    auto clean() noexcept -> void
+    { std::ranges::fill(dirty_, uint8{}); }
+
+    /**
+     * @brief Parses the settings from an XML document.
+     * @details Sets every setting whose tag is found directly below the top-level tag,
+     *     after which the setting is no longer dirty. Other tags are ignored, and
+     *     settings that are missing from the document retain their current value.
+     * @param[in] document XML document to parse.
+     * @return Number of values that were not valid for their setting, see parse_value.
+     */
+    auto fromxml(std::string_view document) -> std::size_t {
+        auto invalid = std::size_t{};
+        xml::parse(document, [this, &invalid](auto path, auto value) {
+            if (path.size() != 2 or path.front() != xml_.tagname) return;
+            auto const setting = find(path.back());
+            if (not setting) return;
+            invalid += setting->try_set(value) != parse_status::ok;
+            dirty_[setting->index_] = 0;
+        });
+        return invalid;
+    }
+
+    /**
+     * @brief Writes the settings as an XML document into the given string, replacing
+     *     its contents, in order of addition.
+     * @param[out] document String to write the XML document into.
+     */
+    auto toxml(std::string& document) const -> void {
+        document.clear();
+        auto out = std::back_inserter(document);
+        auto buffer = std::array<char, max_value_chars>{};
+        std::format_to(out, "<{}>\n", xml_.tagname);
+        for (auto index = uint32{}; index < names_.size(); ++index) {
+            auto const value = visit(index,
+                [&buffer](auto value) { return format_value(value, buffer); });
+            out = std::format_to(out, "    <{0}>{1}</{0}>\n", tags_[index], value);
+        }
+        std::format_to(out, "</{}>\n", xml_.tagname);
+    }
+
+    /**
+     * @brief Loads the settings from their XML file, see fromxml.
+     * @return Number of values that were not valid for their setting.
+     */
+    auto loadxml() -> std::size_t
+    { return fromxml(xml::read(ofToDataPath(xml_.filename))); }
+
+    /**
+     * @brief Saves the settings to their XML file, if any setting changed or the file
+     *     does not exist yet.
+     */
+    auto savexml() -> void {
+        auto const path = ofToDataPath(xml_.filename);
+        auto error = std::error_code{};
+        if (not dirty() and std::filesystem::exists(path, error)) return;
+        auto document = std::string{};
+        toxml(document);
+        if (xml::write(path, document)) clean();
+    }
+
+private:
+    /**
+     * @enum kind
+     * @brief Value-type of a setting.
+     */
+    enum class kind : uint8 { boolean, byte, integer, floating };
+
+    /**
+     * @var kind_v
+     * @brief Kind of the given value type.
+     * @tparam Value Value-type; either bool, uint8, int, or double.
+     */
+    template<typename Value>
+    static constexpr auto kind_v = std::same_as<Value, bool> ? kind::boolean
+        : std::same_as<Value, uint8> ? kind::byte
+        : std::same_as<Value, int> ? kind::integer
+        : kind::floating;
+
+    /**
+     * @union cell
+     * @brief Value of a setting, of which the member that matches its kind is active.
+     */
+    union cell {
+        bool boolean;    /**< Boolean value. */
+        uint8 byte;      /**< Unsigned 8-bit value. */
+        int integer;     /**< Integral value. */
+        double floating; /**< Floating point value. */
+    };
+
+    /**
+     * @brief Returns a cell that holds the given value.
+     * @param[in] value Value to hold.
+     */
+    template<typename Value>
+    [[nodiscard]]
+    static constexpr auto make_cell(Value value) noexcept -> cell {
+        if constexpr (kind_v<Value> == kind::boolean) return {.boolean = value};
+        else if constexpr (kind_v<Value> == kind::byte) return {.byte = value};
+        else if constexpr (kind_v<Value> == kind::integer) return {.integer = value};
+        else return {.floating = value};
+    }
+
+    /**
+     * @struct tag_hash
+     * @brief Hashes tag names, allowing lookup by a view without allocating.
+     */
+    struct tag_hash {
+        using is_transparent = void; /**< Enables heterogeneous lookup. */
+
+        [[nodiscard]]
+        auto operator()(std::string_view tag) const noexcept -> std::size_t
+        { return static_cast<std::size_t>(util::fnv1a(tag)); }
+    };
+
+    /**
+     * @brief Invokes a callable with the value of the setting with the given index.
+     * @tparam Function Callable type, required to accept any value type, and to return
+     *     the same type for each.
+     * @param[in] index Index of the setting.
+     * @param[in] function Callable to invoke.
+     */
+    template<typename Function>
+    auto visit(uint32 index, Function&& function) const
+        -> std::invoke_result_t<Function&, bool>
+    {
+        auto const& value = values_[index];
+        switch (kinds_[index]) {
+        case kind::boolean: return function(value.boolean);
+        case kind::byte:    return function(value.byte);
+        case kind::integer: return function(value.integer);
+        default:            return function(value.floating);
+        }
+    }
+
+    /**
+     * @brief Invokes a callable with a reference to the value of the setting with the
+     *     given index, and marks the setting as changed if its value differs afterwards.
+     * @param[in] index Index of the setting.
+     * @param[in] function Callable to invoke, required to accept any value type.
+     */
+    auto update(uint32 index, auto&& function) noexcept -> void {
+        auto const modify = [this, index, &function](auto& value) {
+            auto const previous = value;
+            function(value);
+            if (value == previous) return;
+            dirty_[index] = 1;
+            ++revisions_[index];
+        };
+        auto& value = values_[index];
+        switch (kinds_[index]) {
+        case kind::boolean: modify(value.boolean); break;
+        case kind::byte:    modify(value.byte); break;
+        case kind::integer: modify(value.integer); break;
+        default:            modify(value.floating); break;
+        }
+    }
+
+    xmlcfg xml_;                     /**< XML configuration. */
+    std::vector<std::string> names_; /**< Name of each setting. */
+    std::vector<std::string> tags_;  /**< Tag name of each setting. */
+    std::vector<kind> kinds_;        /**< Value-type of each setting. */
+    std::vector<cell> values_;       /**< Value of each setting. */
+    std::vector<uint32> revisions_;  /**< Number of times each value changed. */
+    std::vector<uint8> dirty_;       /**< Whether each value changed since it was saved. */
+    std::unordered_map<std::string, uint32, tag_hash, std::equal_to<>> index_;
+                                     /**< Index of the setting with each tag name. */
+};
+
 } // namespace cfg
 
 #endif
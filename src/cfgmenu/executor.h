@@ -0,0 +1,181 @@
+/**
+ * @file       executor.h
+ * @version    0.1
+ * @date       June 2022
+ * @author     Joeri Kok
+ * @author     Rick Horeman
+ * @copyright  GPL-3.0 license
+ *
+ * @brief Execution of tasks in the background.
+ */
+
+#ifndef UTIL_EXECUTOR_H
+#define UTIL_EXECUTOR_H
+
+#include "types.h"
+
+#include <algorithm>
+#include <concepts>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace util
+ * @brief Utility related components.
+ */
+namespace util {
+
+/**
+ * @class executor
+ * @brief Runs tasks one after another on a background thread.
+ * @details Every task is submitted on behalf of an owner. A task that has not started
+ *     yet is superseded when its owner submits another task, so that only the most
+ *     recent task of an owner runs. Each submitted task is identified by a ticket, to
+ *     observe when it is done. A task that throws is done as well, and its exception is
+ *     rethrown by wait. Queued tasks are run before the executor is destroyed.
+ * @tparam Task Task type, required to be invocable without parameters.
+ */
+template<std::invocable Task>
+class executor {
+public:
+    /**
+     * @typedef ticket
+     * @brief Identifies a submitted task. Tickets increase with every submitted task.
+     */
+    using ticket = uint64;
+
+    /**
+     * @brief Starts an executor.
+     */
+    executor():
+        worker_{[this](std::stop_token stop) { run(std::move(stop)); }}
+    {}
+
+    executor(executor const&) = delete;
+    auto operator=(executor const&) -> executor& = delete;
+
+    /**
+     * @brief Submits a task on behalf of the given owner.
+     * @details Supersedes the queued task of the same owner, if any. Never waits for a
+     *     task to run.
+     * @param[in] owner Identifies the owner of the task.
+     * @param[in] task Task to run.
+     * @return Ticket of the submitted task.
+     */
+    auto submit(uint64 owner, Task task) -> ticket {
+        auto const lock = std::scoped_lock{mutex_};
+        std::erase_if(queue_, [owner](auto const& entry) { return entry.owner == owner; });
+        auto const id = ++submitted_;
+        queue_.push_back({owner, id, std::move(task)});
+        queued_.notify_one();
+        return id;
+    }
+
+    /**
+     * @brief Returns whether the task with the given ticket is done.
+     * @details A superseded task counts as done at the latest when the task that
+     *     superseded it is done.
+     * @param[in] id Ticket of the task.
+     */
+    [[nodiscard]]
+    auto done(ticket id) const -> bool {
+        auto const lock = std::scoped_lock{mutex_};
+        return finished_ >= id;
+    }
+
+    /**
+     * @brief Waits until the task with the given ticket is done, see done.
+     * @details The exception of a task that threw is kept until another task of the
+     *     same owner throws, so that only the most recent one of every owner is kept.
+     * @param[in] id Ticket of the task.
+     * @throw Rethrows the exception that the task threw, if any.
+     */
+    auto wait(ticket id) const -> void {
+        auto lock = std::unique_lock{mutex_};
+        progressed_.wait(lock, [this, id] { return finished_ >= id; });
+        auto const failed = std::ranges::find(failures_, id, &failure::id);
+        if (failed != failures_.end()) std::rethrow_exception(failed->error);
+    }
+
+private:
+    /**
+     * @struct entry
+     * @brief Queued task.
+     */
+    struct entry {
+        uint64 owner; /**< Owner of the task. */
+        ticket id;    /**< Ticket of the task. */
+        Task task;    /**< Task to run. */
+    };
+
+    /**
+     * @struct failure
+     * @brief Exception thrown by a task.
+     */
+    struct failure {
+        uint64 owner;             /**< Owner of the task. */
+        ticket id;                /**< Ticket of the task. */
+        std::exception_ptr error; /**< Exception that the task threw. */
+    };
+
+    /**
+     * @brief Runs queued tasks until a stop is requested and the queue is empty.
+     * @details Catches the exception of a task that throws, rather than letting it
+     *     terminate the program, and keeps it for wait.
+     * @param[in] stop Token to observe a stop request with.
+     */
+    auto run(std::stop_token stop) -> void {
+        auto lock = std::unique_lock{mutex_};
+        while (true) {
+            queued_.wait(lock, stop, [this] { return not queue_.empty(); });
+            if (queue_.empty()) return;
+
+            auto current = std::move(queue_.front());
+            queue_.pop_front();
+            lock.unlock();
+            auto error = std::exception_ptr{};
+            try {
+                std::invoke(current.task);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+
+            if (error) fail(current.owner, current.id, std::move(error));
+            finished_ = current.id;
+            progressed_.notify_all();
+        }
+    }
+
+    /**
+     * @brief Keeps the exception of a task, replacing the one of the same owner.
+     * @param[in] owner Owner of the task.
+     * @param[in] id Ticket of the task.
+     * @param[in] error Exception that the task threw.
+     */
+    auto fail(uint64 owner, ticket id, std::exception_ptr error) -> void {
+        auto const previous = std::ranges::find(failures_, owner, &failure::owner);
+        if (previous != failures_.end()) *previous = {owner, id, std::move(error)};
+        else failures_.push_back({owner, id, std::move(error)});
+    }
+
+    std::deque<entry> queue_;                    /**< Tasks that are yet to run. */
+    std::vector<failure> failures_;              /**< Last exception of each owner. */
+    ticket submitted_{};                         /**< Ticket of the last submitted task. */
+    ticket finished_{};                          /**< Ticket of the last finished task. */
+    mutable std::mutex mutex_;                   /**< Guards the queue and tickets. */
+    std::condition_variable_any queued_;         /**< Signals queued tasks. */
+    mutable std::condition_variable progressed_; /**< Signals finished tasks. */
+    std::jthread worker_;                        /**< Runs the tasks. */
+};
+
+} // namespace util
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * @file       function.h
+ * @version    0.1
+ * @date       June 2022
+ * @author     Joeri Kok
+ * @author     Rick Horeman
+ * @copyright  GPL-3.0 license
+ *
+ * @brief Function wrapper with inline storage.
+ */
+
+#ifndef UTIL_FUNCTION_H
+#define UTIL_FUNCTION_H
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @namespace util
+ * @brief Utility related components.
+ */
+namespace util {
+
+template<typename Signature, std::size_t Capacity = 4 * sizeof(void*)>
+class inplace_function;
+
+/**
+ * @class inplace_function
+ * @brief Type-erased callable that is stored inline instead of on the heap.
+ * @details Behaves like std::function, except that it never allocates: a callable that
+ *     does not fit in the inline storage is rejected at compile time. Invoking it costs
+ *     a single indirect call.
+ * @tparam Result Result type of the signature.
+ * @tparam Args Parameter types of the signature.
+ * @tparam Capacity Size of the inline storage in bytes.
+ */
+template<typename Result, typename... Args, std::size_t Capacity>
+class inplace_function<Result(Args...), Capacity> {
+public:
+    /**
+     * @brief Default constructs an empty function.
+     */
+    inplace_function() = default;
+
+    /**
+     * @brief Constructs a function that stores the given callable.
+     * @tparam Function Callable type, required to be invocable with the parameters of the
+     *     signature, and to fit in the inline storage.
+     * @param[in] function Callable to store.
+     */
+    template<typename Function>
+        requires (not std::same_as<std::remove_cvref_t<Function>, inplace_function>)
+            and std::is_invocable_r_v<Result, std::decay_t<Function>&, Args...>
+    inplace_function(Function&& function) {
+        using stored_type = std::decay_t<Function>;
+        static_assert(sizeof(stored_type) <= Capacity,
+            "callable does not fit in the inline storage");
+        static_assert(alignof(stored_type) <= alignof(std::max_align_t),
+            "callable is overaligned for the inline storage");
+        static_assert(std::is_nothrow_move_constructible_v<stored_type>,
+            "callable is required to be nothrow move constructible");
+        static_assert(std::copy_constructible<stored_type>,
+            "callable is required to be copy constructible");
+
+        ::new (static_cast<void*>(storage_)) stored_type(std::forward<Function>(function));
+        invoke_ = invoke<stored_type>;
+        ops_ = std::addressof(ops_v<stored_type>);
+    }
+
+    /**
+     * @brief Copy constructs a function, copying the stored callable.
+     */
+    inplace_function(inplace_function const& other):
+        invoke_{other.invoke_},
+        ops_{other.ops_}
+    { if (ops_ != nullptr) ops_->copy(storage_, other.storage_); }
+
+    /**
+     * @brief Move constructs a function, moving the stored callable.
+     */
+    inplace_function(inplace_function&& other) noexcept:
+        invoke_{other.invoke_},
+        ops_{other.ops_}
+    {
+        if (ops_ != nullptr) ops_->move(storage_, other.storage_);
+        other.invoke_ = nullptr;
+        other.ops_ = nullptr;
+    }
+
+    /**
+     * @brief Copy assigns a function, copying the stored callable.
+     */
+    auto operator=(inplace_function const& other) -> inplace_function& {
+        if (this != std::addressof(other)) {
+            reset();
+            if (other.ops_ != nullptr) other.ops_->copy(storage_, other.storage_);
+            invoke_ = other.invoke_;
+            ops_ = other.ops_;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Move assigns a function, moving the stored callable.
+     */
+    auto operator=(inplace_function&& other) noexcept -> inplace_function& {
+        if (this != std::addressof(other)) {
+            reset();
+            if (other.ops_ != nullptr) other.ops_->move(storage_, other.storage_);
+            invoke_ = std::exchange(other.invoke_, nullptr);
+            ops_ = std::exchange(other.ops_, nullptr);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Destroys the stored callable, if any.
+     */
+    ~inplace_function()
+    { reset(); }
+
+    /**
+     * @brief Invokes the stored callable with the given arguments.
+     * @pre Ensure the function is not empty before calling this function.
+     * @param[in] args Arguments to invoke the stored callable with.
+     */
+    auto operator()(Args... args) const -> Result
+    { return invoke_(storage_, std::forward<Args>(args)...); }
+
+    /**
+     * @brief Contextually converts a function to whether it stores a callable.
+     */
+    [[nodiscard]]
+    explicit operator bool() const noexcept
+    { return invoke_ != nullptr; }
+
+private:
+    /**
+     * @struct operations
+     * @brief Operations on a stored callable of a particular type.
+     */
+    struct operations {
+        void (*copy)(void*, void const*);    /**< Copy constructs into storage. */
+        void (*move)(void*, void*) noexcept; /**< Move constructs into storage. */
+        void (*destroy)(void*) noexcept;     /**< Destroys the stored callable. */
+    };
+
+    /**
+     * @brief Invokes a stored callable of the given type.
+     * @tparam Function Type of the stored callable.
+     * @param[in] function Storage of the callable.
+     * @param[in] args Arguments to invoke the callable with.
+     */
+    template<typename Function>
+    static auto invoke(void* function, Args&&... args) -> Result {
+        auto& stored = *std::launder(static_cast<Function*>(function));
+        if constexpr (std::is_void_v<Result>) {
+            std::invoke(stored, std::forward<Args>(args)...);
+        } else {
+            return std::invoke(stored, std::forward<Args>(args)...);
+        }
+    }
+
+    /**
+     * @var ops_v
+     * @brief Operations on a stored callable of the given type.
+     * @tparam Function Type of the stored callable.
+     */
+    template<typename Function>
+    static constexpr auto ops_v = operations{
+        .copy = [](void* target, void const* source) {
+            ::new (target) Function(*std::launder(static_cast<Function const*>(source)));
+        },
+        .move = [](void* target, void* source) noexcept {
+            auto& function = *std::launder(static_cast<Function*>(source));
+            ::new (target) Function(std::move(function));
+            function.~Function();
+        },
+        .destroy = [](void* function) noexcept
+        { std::launder(static_cast<Function*>(function))->~Function(); }
+    };
+
+    /**
+     * @brief Destroys the stored callable, if any, leaving the function empty.
+     */
+    auto reset() noexcept -> void {
+        if (ops_ != nullptr) ops_->destroy(storage_);
+        invoke_ = nullptr;
+        ops_ = nullptr;
+    }
+
+    alignas(std::max_align_t) mutable std::byte storage_[Capacity]; /**< Callable. */
+    Result (*invoke_)(void*, Args&&...){}; /**< Invokes the stored callable. */
+    operations const* ops_{};              /**< Operations on the stored callable. */
+};
+
+} // namespace util
+
+#endif
@@ -13,15 +13,26 @@
 #define UI_MENU_H
 
 #include "concepts.h"
+#include "executor.h"
+#include "function.h"
+#include "slotmap.h"
+#include "types.h"
 #include "utility.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
+#include <chrono>
 #include <concepts>
+#include <cstddef>
 #include <format>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -31,15 +42,76 @@
  */
 namespace ui {
 
+/**
+ * @typedef action
+ * @brief Menu action that stores its callable inline instead of on the heap.
+ * @details Keeps menu options free of allocations, and rejects any callable that does
+ *     not fit at compile time, see util::inplace_function.
+ */
+using action = util::inplace_function<void()>;
+
+/**
+ * @enum pace
+ * @brief Determines when applying a menu option invokes its action.
+ */
+enum class pace : uint8 {
+    immediate, /**< Invokes the action on every apply. */
+    ratelimit, /**< Invokes the action at most once per interval, and once afterwards. */
+    debounce   /**< Invokes the action once applying stopped for an interval. */
+};
+
+/**
+ * @struct action_policy
+ * @brief Paces the action of a menu option, e.g. to keep key-repeat bursts from
+ *     invoking an expensive action over and over, and tells which menu options share
+ *     their action.
+ * @details Deferred actions are invoked by polling the menu option, see
+ *     menu_option::poll. Menu options with the same non-zero share key are meant to
+ *     do the same thing, e.g. reconfigure the camera, so that a transaction invokes
+ *     only one of their actions, see menu::transaction.
+ */
+struct action_policy {
+    /**
+     * @brief Compares two objects for equality.
+     */
+    [[nodiscard]]
+    friend auto operator==(action_policy const&, action_policy const&) -> bool = default;
+
+    pace kind{};                          /**< When to invoke the action. */
+    std::chrono::milliseconds interval{}; /**< Interval to pace the action with. */
+    uint32 share{};                       /**< Shared action key, or zero if distinct. */
+};
+
 /**
  * @class menu_option
  * @brief Menu option.
  * @details Maps a key to a configurable item and an optional action.
- * @tparam ConfigItem Configuration item type, required to be configurable.
+ * @tparam ConfigItem Configuration item type, required to be configurable. Handles to
+ *     configurable items are stored by value, any other item is referred to by pointer.
  * @tparam Action Action type, required to be invocable without parameters.
  */
 template<cc::configurable ConfigItem, std::invocable Action>
 class menu_option {
+    using clock = std::chrono::steady_clock;       /**< Clock to pace the action with. */
+    using ticket = util::executor<Action>::ticket; /**< Identifies a submitted action. */
+
+    /**
+     * @brief Whether the configuration item type is a handle.
+     */
+    static constexpr auto handle = cc::configurable_handle<ConfigItem>;
+
+    /**
+     * @brief Size of the buffer that the value of the configuration item is formatted
+     *     into.
+     */
+    static constexpr auto value_chars = std::size_t{32};
+
+    /**
+     * @brief Size of the buffer that the string representation of the menu option is
+     *     cached in. Names that do not fit next to any value are truncated.
+     */
+    static constexpr auto row_chars = std::size_t{64};
+
 public:
     /**
      * @brief Default constructs a menu option.
@@ -53,29 +125,148 @@ public:
      * @param[in] cfgitem Existing configuration item to set when applying a menu option.
      * @param[in] action Optional action to invoke when applying a menu option. Defaulted
      *     to an empty action.
+     * @param[in] policy Optional policy to pace the action with. Defaulted to invoking
+     *     the action on every apply.
      */
-    constexpr menu_option(
+    menu_option(
         unsigned char key,
         ConfigItem& cfgitem,
-        Action action = {}
-    ):
+        Action action = {},
+        action_policy policy = {}
+    ) requires (not handle):
+        action_{std::move(action)},
+        cfgitem_{std::addressof(cfgitem)},
         key_{key},
+        policy_{policy},
+        id_{++last_id_}
+    {}
+
+    /**
+     * @brief Constructs a menu option with the given key, handle to a configuration
+     *     item, and optional action.
+     * @param[in] key Key to uniquely identify a menu option.
+     * @param[in] cfgitem Handle to the configuration item to set when applying a menu
+     *     option.
+     * @param[in] action Optional action to invoke when applying a menu option. Defaulted
+     *     to an empty action.
+     * @param[in] policy Optional policy to pace the action with. Defaulted to invoking
+     *     the action on every apply.
+     */
+    menu_option(
+        unsigned char key,
+        ConfigItem cfgitem,
+        Action action = {},
+        action_policy policy = {}
+    ) requires handle:
         action_{std::move(action)},
-        cfgitem_{std::addressof(cfgitem)}
+        cfgitem_{std::move(cfgitem)},
+        key_{key},
+        policy_{policy},
+        id_{++last_id_}
     {}
 
     /**
      * @brief Applies a menu option with the given value.
-     * @details Sets the configuration item with the given value and invokes the stored
-     *     action if not empty.
+     * @details Sets the configuration item with the given value right away, and invokes
+     *     the stored action if not empty, as paced by the action policy. An action that
+     *     is deferred by the policy is invoked by a later poll.
+     * @tparam Value Type of the value.
+     * @param[in] value Value to set the configuration item with.
+     * @param[in] now Time at which the menu option is applied.
+     */
+    template<typename Value>
+    auto apply(Value&& value, clock::time_point now = clock::now()) -> void {
+        set(std::forward<Value>(value));
+        if (not action_) return;
+
+        switch (policy_.kind) {
+        case pace::immediate:
+            invoke();
+            break;
+        case pace::ratelimit:
+            pending_ = true;
+            poll(now);
+            break;
+        case pace::debounce:
+            pending_ = true;
+            invoked_ = now;
+            break;
+        }
+    }
+
+    /**
+     * @brief Applies a menu option with the given value, running the stored action on the
+     *     given executor.
+     * @details Sets the configuration item with the given value right away, and submits
+     *     the stored action if not empty, regardless of the action policy. Supersedes the
+     *     action of a previous apply of the same menu option that has not started yet.
+     * @tparam Value Type of the value.
+     * @param[in] value Value to set the configuration item with.
+     * @param[in] executor Executor to run the action on.
+     * @return Ticket to observe when the action is done with, see util::executor::done.
+     *     Equals the initial ticket if there is no action, which is done right away.
+     */
+    template<typename Value>
+    auto apply(Value&& value, util::executor<Action>& executor) -> ticket {
+        set(std::forward<Value>(value));
+        if (not action_) return {};
+        return executor.submit(id_, action_);
+    }
+
+    /**
+     * @brief Invokes the action that was deferred by the action policy, once it is due.
+     * @details Meant to be called regularly, e.g. once per frame.
+     * @param[in] now Current time.
+     */
+    auto poll(clock::time_point now = clock::now()) -> void {
+        if (not pending_ or now - invoked_ < policy_.interval) return;
+        pending_ = false;
+        invoked_ = now;
+        invoke();
+    }
+
+    /**
+     * @brief Returns whether an action was deferred by the action policy.
+     */
+    [[nodiscard]]
+    constexpr auto pending() const noexcept -> bool
+    { return pending_; }
+
+    /**
+     * @brief Sets the configuration item with the given value, without invoking the
+     *     stored action.
      * @tparam Value Type of the value.
      * @param[in] value Value to set the configuration item with.
      */
     template<typename Value>
-    constexpr auto apply(Value&& value) -> void {
-        cfgitem_->set(std::forward<Value>(value));
+    constexpr auto set(Value&& value) -> void
+    { item().set(std::forward<Value>(value)); }
+
+    /**
+     * @brief Invokes the stored action if not empty.
+     */
+    constexpr auto invoke() -> void {
         if (not action_) return;
-        std::invoke(std::forward<Action>(action_));
+        std::invoke(action_);
+    }
+
+    /**
+     * @brief Returns whether the menu option has a non-empty action.
+     */
+    [[nodiscard]]
+    constexpr auto has_action() const noexcept -> bool
+    { return static_cast<bool>(action_); }
+
+    /**
+     * @brief Returns whether two menu options share the same action.
+     * @details Menu options share their action with themselves, and with each other
+     *     when their action policies have the same non-zero share key.
+     * @param[in] other Menu option to compare the action with.
+     */
+    [[nodiscard]]
+    constexpr auto shares_action(menu_option const& other) const noexcept -> bool {
+        if (this == std::addressof(other)) return true;
+        return policy_.share != 0 and policy_.share == other.policy_.share;
     }
 
     /**
@@ -86,9 +277,32 @@ public:
      */
     template<std::same_as<std::string> String>
     [[nodiscard]]
-    constexpr auto to() const -> String {
-        return std::format("{:20} {:>16}\n",
-            cfgitem_->name(), cfgitem_->to<std::string>());
+    constexpr auto to() const -> String
+    { return String{row()}; }
+
+    /**
+     * @brief Returns the cached string representation of a menu option.
+     * @details Only formats the representation again when the configuration item
+     *     changed since it was last formatted. Items without a revision number are
+     *     formatted every time. Either way, the representation is formatted into a
+     *     buffer within the menu option, and therefore never allocates.
+     * @remark Not safe to call concurrently on the same menu option.
+     * @return View of the representation, valid until the next call.
+     */
+    [[nodiscard]]
+    constexpr auto row() const -> std::string_view {
+        if constexpr (cc::revisioned<ConfigItem>) {
+            auto const revision = item().revision();
+            if (row_size_ != 0 and revision == revision_) return {row_.data(), row_size_};
+            revision_ = revision;
+        }
+        auto buffer = std::array<char, value_chars>{};
+        auto const name = item().name().substr(0, row_chars - value_chars - 2);
+        auto const end = std::format_to_n(row_.data(), row_.size() - 1, "{:20} {:>16}",
+            name, item().format_to(buffer)).out;
+        *end = '\n';
+        row_size_ = static_cast<uint8>(end - row_.data() + 1);
+        return {row_.data(), row_size_};
     }
 
     /**
@@ -107,40 +321,87 @@ public:
     { return lhs.key() == rhs.key(); }
 
 private:
-    Action action_;                        /**< Optional menu action. */
-    util::access_ptr<ConfigItem> cfgitem_; /**< Configuration item. */
-    unsigned char key_;                    /**< Key to uniquely identify a menu option. */
+    /**
+     * @typedef item_type
+     * @brief Stored configuration item type; either a handle or a pointer.
+     */
+    using item_type = std::conditional_t<handle, ConfigItem, util::access_ptr<ConfigItem>>;
+
+    /**
+     * @brief Returns the configuration item, regardless of how it is stored.
+     */
+    [[nodiscard]]
+    constexpr auto item() const noexcept -> decltype(auto) {
+        if constexpr (handle) return (cfgitem_);
+        else return *cfgitem_;
+    }
+
+    Action action_;             /**< Optional menu action. */
+    item_type cfgitem_;         /**< Configuration item. */
+    unsigned char key_;         /**< Key to uniquely identify a menu option. */
+    action_policy policy_;      /**< Paces the menu action. */
+    clock::time_point invoked_; /**< Last invocation, or last apply when debouncing. */
+    bool pending_{};            /**< Menu action was deferred. */
+    uint64 id_{};               /**< Identifies the menu action on an executor. */
+    mutable std::array<char, row_chars> row_{};
+                                /**< Cached string representation. */
+    mutable uint8 row_size_{};  /**< Size of the cached string representation. */
+    mutable uint32 revision_{}; /**< Revision of the item when it was last formatted. */
+
+    inline static std::atomic<uint64> last_id_{}; /**< Last assigned menu action ID. */
 };
 
 /**
  * @class menu
  * @brief Menu.
- * @details Consists of a set of menu options and holds a menu selection.
+ * @details Consists of a set of menu options and holds a menu selection. Menu options
+ *     are referred to by handles that stay valid until their option is removed, so the
+ *     menu selection survives adding and removing other options. Keeps a table that
+ *     maps every key to its menu option, so that selecting takes constant time.
  * @tparam ConfigItem Configuration item type, required to be configurable.
  * @tparam Action Action type, required to be invocable without parameters.
  */
 template<cc::configurable ConfigItem, std::invocable Action>
 class menu {
     using option_type = menu_option<ConfigItem, Action>; /**< Menu option object. */
+    using storage_type = util::slot_map<option_type>;    /**< Menu options container type. */
+    using handle_type = storage_type::handle;            /**< Handle to a menu option. */
 
 public:
     /**
      * @brief Adds a menu option to the menu.
-     * @post Invalidates the current menu selection when a reallocation is required.
+     * @details Takes constant time and keeps the current menu selection intact.
      * @tparam Ts Optional argument types.
      * @param[in] key Key to uniquely identify a menu option.
      * @param[in] args Optional arguments to construct a menu option with.
      */
     template<typename... Ts>
-    constexpr auto add(unsigned char key, Ts&&... args) -> void
-    { options_.emplace_back(key, std::forward<Ts>(args)...); }
+    constexpr auto add(unsigned char key, Ts&&... args) -> void {
+        auto const option = options_.emplace(key, std::forward<Ts>(args)...);
+        auto& entry = index_[key];
+        if (entry.count++ == 0) entry.option = option;
+    }
 
     /**
-     * @brief Removes a menu option from the menu.
-     * @pre Ensure the current menu selection is valid before calling this function.
+     * @brief Removes the selected menu option from the menu.
+     * @details Takes constant time, unless another menu option shares the key of the
+     *     removed option. Other menu options are not affected.
+     * @post Clears the current menu selection.
+     * @return If a menu option was removed, returns true. Otherwise, returns false.
      */
-    constexpr auto remove() -> void
-    { options_.erase(selection); }
+    constexpr auto remove() -> bool {
+        if (not options_.contains(selection_)) return false;
+        auto const key = options_[selection_].key();
+        options_.erase(std::exchange(selection_, {}));
+
+        auto& entry = index_[key];
+        if (--entry.count == 0) {
+            entry.option = {};
+        } else if (not options_.contains(entry.option)) {
+            entry.option = find(key);
+        }
+        return true;
+    }
 
     /**
      * @brief Selects a menu option with the given key.
@@ -148,22 +409,118 @@ public:
      * @return If the menu option was found, returns true. Otherwise, returns false.
      */
     constexpr auto select(unsigned char key) noexcept -> bool {
-        selection_ = std::ranges::find_if(options_,
-            [key](auto const& option){ return option.key() == key; });
-        return selection_ != options_.end();
+        selection_ = index_[key].option;
+        return options_.contains(selection_);
     }
 
+    /**
+     * @brief Returns whether a menu option is selected.
+     * @details The menu selection stays valid until the selected option is removed.
+     */
+    [[nodiscard]]
+    constexpr auto selected() const noexcept -> bool
+    { return options_.contains(selection_); }
+
+    /**
+     * @brief Invokes the actions of all menu options that were deferred by their action
+     *     policy, once they are due, see menu_option::poll.
+     * @details Meant to be called regularly, e.g. once per frame.
+     * @param[in] now Current time.
+     */
+    auto poll(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now())
+        -> void
+    { for (auto& option : options_) option.poll(now); }
+
+    /**
+     * @class transaction
+     * @brief Applies several menu options at once, invoking each distinct action once.
+     * @details Sets the configuration items right away, but defers their actions until
+     *     the transaction is committed. Menu options that share an action, see
+     *     menu_option::shares_action, have it invoked only once. Committing is explicit,
+     *     so that an action that throws propagates to the caller: the actions of a
+     *     transaction that is destroyed without being committed are not invoked.
+     */
+    class transaction {
+    public:
+        /**
+         * @brief Starts a transaction on the given menu.
+         * @param[in] owner Menu to apply the menu options of.
+         */
+        explicit transaction(menu& owner) noexcept:
+            menu_{std::addressof(owner)}
+        {}
+
+        transaction(transaction const&) = delete;
+        auto operator=(transaction const&) -> transaction& = delete;
+
+        /**
+         * @brief Applies the menu option with the given key, deferring its action.
+         * @tparam Value Type of the value.
+         * @param[in] key Key of the menu option to apply.
+         * @param[in] value Value to set the configuration item with.
+         * @return If the menu option was found, returns true. Otherwise, returns false.
+         */
+        template<typename Value>
+        auto apply(unsigned char key, Value&& value) -> bool {
+            auto& options = menu_->options_;
+            auto const handle = menu_->index_[key].option;
+            if (not options.contains(handle)) return false;
+
+            auto& option = options[handle];
+            option.set(std::forward<Value>(value));
+            if (not option.has_action()) return true;
+
+            auto const shared = std::ranges::any_of(pending_, [&](auto pending) {
+                return options.contains(pending) and options[pending].shares_action(option);
+            });
+            if (not shared) pending_.push_back(handle);
+            return true;
+        }
+
+        /**
+         * @brief Invokes the distinct actions of the applied menu options.
+         * @details Actions of menu options that were removed in the meantime are skipped.
+         *     The transaction can be used again afterwards, also when an action threw, in
+         *     which case the remaining actions are not invoked.
+         */
+        auto commit() -> void {
+            auto& options = menu_->options_;
+            for (auto const handle : std::exchange(pending_, {})) {
+                if (options.contains(handle)) options[handle].invoke();
+            }
+        }
+
+    private:
+        menu* menu_;                       /**< Menu to apply the menu options of. */
+        std::vector<handle_type> pending_; /**< Menu options with a distinct action. */
+    };
+
+    /**
+     * @brief Starts a transaction on the menu.
+     */
+    [[nodiscard]]
+    auto transact() noexcept -> transaction
+    { return transaction{*this}; }
+
     /**
      * @brief Returns a reference to the selected menu option.
      * @pre Ensure the current menu selection is valid before calling this function.
+     * @{
      */
     [[nodiscard]]
-    constexpr auto selection() const noexcept -> option_type&
-    { return *selection_; }
+    constexpr auto selection() noexcept -> option_type&
+    { return options_[selection_]; }
+
+    [[nodiscard]]
+    constexpr auto selection() const noexcept -> option_type const&
+    { return options_[selection_]; }
+    /** @} */
 
     /**
      * @brief Returns a string representation of a menu.
-     * @details Contains the string representation of all menu options.
+     * @details Contains the string representation of all menu options, in the order in
+     *     which they were added. Concatenates the cached representations of the menu
+     *     options, so that only the options whose item changed are formatted again.
      * @tparam String Representation type, required to be a std::string.
      * @remark The type-constraint is there for future specializations.
      */
@@ -171,12 +528,13 @@ public:
     [[nodiscard]]
     constexpr auto to() const -> String {
         auto result = String{};
-        auto const max_option_name = 32;
+        auto const max_option_name = 48;
         result.reserve(max_option_name * options_.size());
 
         for (auto const& option : options_) {
-            result += std::format("{:c} | {}",
-                std::toupper(option.key()), option.to<String>());
+            result += static_cast<char>(std::toupper(option.key()));
+            result += " | ";
+            result += option.row();
         }
         return result;
     }
@@ -188,11 +546,43 @@ public:
     friend auto operator==(menu const&, menu const&) -> bool = default;
 
 private:
-    using storage_type = std::vector<option_type>; /**< Menu options container type. */
-    using selection_type = storage_type::iterator; /**< Menu selection type. */
+    /**
+     * @struct key_entry
+     * @brief Maps a key to its menu option.
+     */
+    struct key_entry {
+        /**
+         * @brief Compares two objects for equality.
+         */
+        [[nodiscard]]
+        friend auto operator==(key_entry const&, key_entry const&) -> bool = default;
+
+        handle_type option; /**< First added menu option with the key. */
+        uint32 count;       /**< Number of menu options with the key. */
+    };
+
+    /**
+     * @typedef key_index_type
+     * @brief Maps every possible key to its menu option.
+     */
+    using key_index_type = std::array<key_entry,
+        std::numeric_limits<unsigned char>::max() + 1>;
+
+    /**
+     * @brief Returns the handle of the first added menu option with the given key.
+     * @param[in] key Key of the menu option to find.
+     */
+    [[nodiscard]]
+    constexpr auto find(unsigned char key) const noexcept -> handle_type {
+        for (auto option = options_.begin(); option != options_.end(); ++option) {
+            if ((*option).key() == key) return option.key();
+        }
+        return {};
+    }
 
-    storage_type options_;     /**< Menu options. */
-    selection_type selection_; /**< Menu selection. */
+    storage_type options_;   /**< Menu options. */
+    handle_type selection_;  /**< Menu selection. */
+    key_index_type index_{}; /**< Menu option per key. */
 };
 
 } // namespace ui
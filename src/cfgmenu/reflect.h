@@ -0,0 +1,373 @@
+/**
+ * @file       reflect.h
+ * @version    0.1
+ * @date       June 2022
+ * @author     Joeri Kok
+ * @author     Rick Horeman
+ * @copyright  GPL-3.0 license
+ *
+ * @brief Compile-time enumeration of the members of aggregates, and of the
+ *     enumerators of enumerations.
+ * @note Member and enumerator names are taken from __PRETTY_FUNCTION__, and are
+ *     therefore only available with GCC and Clang.
+ */
+
+#ifndef REFL_REFLECT_H
+#define REFL_REFLECT_H
+
+#include "utility.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @namespace refl
+ * @brief Reflection related components.
+ */
+namespace refl {
+
+/**
+ * @namespace detail
+ * @brief Implementation details.
+ */
+namespace detail {
+
+/**
+ * @struct any_member
+ * @brief Placeholder that initializes a member of any type, used to count members.
+ */
+struct any_member {
+    /**
+     * @brief Converts to a member of any type; only used in unevaluated contexts.
+     * @tparam T Type of the member.
+     */
+    template<typename T>
+    constexpr operator T&() const noexcept;
+};
+
+/**
+ * @brief Returns the number of members of the given aggregate type.
+ * @details Adds placeholders to the initializer of the aggregate for as long as it
+ *     remains well-formed.
+ * @tparam T Aggregate type.
+ * @tparam Members Placeholders that have been added so far.
+ */
+template<typename T, typename... Members>
+consteval auto member_count() noexcept -> std::size_t {
+    if constexpr (requires { T{Members{}..., any_member{}}; }) {
+        return member_count<T, Members..., any_member>();
+    } else {
+        return sizeof...(Members);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @var member_count_v
+ * @brief Number of members of an aggregate type.
+ * @tparam T Aggregate type, possibly cv-qualified.
+ */
+template<typename T>
+    requires std::is_aggregate_v<std::remove_cv_t<T>>
+inline constexpr auto member_count_v = detail::member_count<std::remove_cv_t<T>>();
+
+/**
+ * @brief Returns a tuple of references to the members of an aggregate.
+ * @details Binds the members by a structured binding, so that accessing them through
+ *     the tuple compiles to plain member accesses.
+ * @tparam T Aggregate type, possibly const-qualified, with at most twelve members.
+ * @param[in] aggregate Aggregate to refer to the members of.
+ */
+template<typename T>
+[[nodiscard]]
+constexpr auto tie(T& aggregate) noexcept {
+    constexpr auto count = member_count_v<T>;
+    static_assert(count <= 12, "aggregate has too many members to be tied");
+
+    if constexpr (count == 0) {
+        return std::tuple{};
+    } else if constexpr (count == 1) {
+        auto& [m1] = aggregate;
+        return std::tie(m1);
+    } else if constexpr (count == 2) {
+        auto& [m1, m2] = aggregate;
+        return std::tie(m1, m2);
+    } else if constexpr (count == 3) {
+        auto& [m1, m2, m3] = aggregate;
+        return std::tie(m1, m2, m3);
+    } else if constexpr (count == 4) {
+        auto& [m1, m2, m3, m4] = aggregate;
+        return std::tie(m1, m2, m3, m4);
+    } else if constexpr (count == 5) {
+        auto& [m1, m2, m3, m4, m5] = aggregate;
+        return std::tie(m1, m2, m3, m4, m5);
+    } else if constexpr (count == 6) {
+        auto& [m1, m2, m3, m4, m5, m6] = aggregate;
+        return std::tie(m1, m2, m3, m4, m5, m6);
+    } else if constexpr (count == 7) {
+        auto& [m1, m2, m3, m4, m5, m6, m7] = aggregate;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7);
+    } else if constexpr (count == 8) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8] = aggregate;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8);
+    } else if constexpr (count == 9) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9] = aggregate;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9);
+    } else if constexpr (count == 10) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10] = aggregate;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10);
+    } else if constexpr (count == 11) {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11] = aggregate;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11);
+    } else {
+        auto& [m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12] = aggregate;
+        return std::tie(m1, m2, m3, m4, m5, m6, m7, m8, m9, m10, m11, m12);
+    }
+}
+
+/**
+ * @brief Returns a tuple of references to the leaves of a nested aggregate.
+ * @details Enumerates the members depth-first, in order of declaration. Members that
+ *     are leaves are kept, members that are aggregates themselves are enumerated in
+ *     turn, and any other member is left out.
+ * @tparam Leaf Type trait that tells whether a type is a leaf.
+ * @tparam T Aggregate type, possibly const-qualified.
+ * @param[in] aggregate Aggregate to refer to the leaves of.
+ */
+template<template<typename> typename Leaf, typename T>
+[[nodiscard]]
+constexpr auto flatten(T& aggregate) noexcept {
+    return std::apply([](auto&... members) {
+        auto const leaves = []<typename Member>(Member& member) {
+            using member_type = std::remove_cv_t<Member>;
+            if constexpr (Leaf<member_type>::value) return std::tie(member);
+            else if constexpr (std::is_aggregate_v<member_type>) return flatten<Leaf>(member);
+            else return std::tuple{};
+        };
+        return std::tuple_cat(leaves(members)...);
+    }, tie(aggregate));
+}
+
+namespace detail {
+
+/**
+ * @var fake_v
+ * @brief Object of the given type that is never defined, so that the addresses of its
+ *     members can be named at compile time.
+ * @tparam T Aggregate type.
+ */
+template<typename T>
+extern T const fake_v;
+
+/**
+ * @struct member_ptr
+ * @brief Wraps a pointer to a member of fake_v, to pass it as a template argument.
+ * @tparam T Type of the member.
+ */
+template<typename T>
+struct member_ptr {
+    T const* pointer; /**< Points to the member. */
+};
+
+/**
+ * @brief Returns the signature of this function, which spells out its template
+ *     argument, e.g. including the name of the member it points to.
+ * @tparam Value Template argument to spell out, e.g. a pointer to a member of fake_v.
+ */
+template<auto Value>
+consteval auto signature() noexcept
+{ return std::string_view{__PRETTY_FUNCTION__}; }
+
+/**
+ * @brief Returns whether the given character may appear in an identifier.
+ * @param[in] c Character to check.
+ */
+consteval auto identifier(char c) noexcept -> bool {
+    return c == '_' or (c >= '0' and c <= '9')
+        or (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z');
+}
+
+/**
+ * @brief Returns the last identifier in the given text.
+ * @param[in] text Text to search, e.g. the signature of signature().
+ */
+consteval auto last_identifier(std::string_view text) noexcept -> std::string_view {
+    auto const end = text.find_last_of("_0123456789"
+        "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ") + 1;
+    auto begin = end;
+    while (begin > 0 and identifier(text[begin - 1])) --begin;
+    return text.substr(begin, end - begin);
+}
+
+/**
+ * @brief Returns the name of the member of the given aggregate type with the given
+ *     index.
+ * @details Takes the last identifier from the signature of signature(), which ends
+ *     with the name of the member, followed by closing brackets only.
+ * @tparam T Aggregate type.
+ * @tparam Index Index of the member.
+ */
+template<typename T, std::size_t Index>
+consteval auto member_name() noexcept -> std::string_view {
+    constexpr auto member = std::addressof(std::get<Index>(tie(fake_v<T>)));
+    return last_identifier(signature<member_ptr{member}>());
+}
+
+/**
+ * @brief Number of values of an enumeration that are checked for an enumerator.
+ */
+inline constexpr auto max_enumerators = std::size_t{64};
+
+/**
+ * @brief Returns the name of the enumerator with the given value.
+ * @details Takes the last identifier from the signature of signature(), which ends
+ *     with the name of the enumerator. A value without an enumerator is spelled out as
+ *     a cast of a number instead, e.g. "(cam::format)2", which leaves a number.
+ * @tparam Value Value of an enumeration.
+ * @return If the value has an enumerator, returns its name. Otherwise, returns an
+ *     empty view.
+ */
+template<auto Value>
+consteval auto enumerator_name() noexcept -> std::string_view {
+    constexpr auto name = last_identifier(signature<Value>());
+    if (name.empty() or (name.front() >= '0' and name.front() <= '9')) return {};
+    return name;
+}
+
+/**
+ * @brief Returns the number of enumerators of the given enumeration, counting from the
+ *     value zero up to the first value without an enumerator.
+ * @tparam Enum Enumeration type.
+ * @tparam Values Values to check, up to max_enumerators.
+ */
+template<typename Enum, std::size_t... Values>
+consteval auto enumerator_count(std::index_sequence<Values...>) noexcept -> std::size_t {
+    constexpr auto named = std::array{
+        not enumerator_name<static_cast<Enum>(Values)>().empty()...};
+    return static_cast<std::size_t>(std::ranges::find(named, false) - named.begin());
+}
+
+} // namespace detail
+
+/**
+ * @var member_name_v
+ * @brief Name of the member of an aggregate type with the given index.
+ * @tparam T Aggregate type, possibly cv-qualified.
+ * @tparam Index Index of the member.
+ */
+template<typename T, std::size_t Index>
+    requires (Index < member_count_v<T>)
+inline constexpr auto member_name_v = detail::member_name<std::remove_cv_t<T>, Index>();
+
+/**
+ * @brief Returns the index of the member of an aggregate type with the given name.
+ * @tparam T Aggregate type, possibly cv-qualified.
+ * @param[in] name Name of the member.
+ * @return If a member was found, returns its index. Otherwise, returns the number of
+ *     members.
+ */
+template<typename T>
+[[nodiscard]]
+consteval auto member_index(std::string_view name) noexcept -> std::size_t {
+    constexpr auto names = []<std::size_t... Indices>(std::index_sequence<Indices...>) {
+        return std::array<std::string_view, sizeof...(Indices)>{
+            member_name_v<T, Indices>...};
+    }(std::make_index_sequence<member_count_v<T>>{});
+    return static_cast<std::size_t>(std::ranges::find(names, name) - names.begin());
+}
+
+/**
+ * @var enum_names_v
+ * @brief Names of the enumerators of an enumeration, indexed by their values.
+ * @details Covers the enumerators with consecutive values starting at zero, which is
+ *     how enumerators are numbered unless given explicit values.
+ * @tparam Enum Enumeration type.
+ */
+template<typename Enum>
+    requires std::is_enum_v<Enum>
+inline constexpr auto enum_names_v = []<std::size_t... Values>(
+    std::index_sequence<Values...>
+) {
+    return std::array<std::string_view, sizeof...(Values)>{
+        detail::enumerator_name<static_cast<Enum>(Values)>()...};
+}(std::make_index_sequence<detail::enumerator_count<Enum>(
+    std::make_index_sequence<detail::max_enumerators>{})>{});
+
+namespace detail {
+
+/**
+ * @var enum_index_v
+ * @brief Perfect hash of the names of the enumerators of an enumeration.
+ * @tparam Enum Enumeration type.
+ */
+template<typename Enum>
+inline constexpr auto enum_index_v = util::perfect_index{enum_names_v<Enum>};
+
+} // namespace detail
+
+/**
+ * @brief Returns the name of the enumerator with the given value, see enum_names_v.
+ * @tparam Enum Enumeration type.
+ * @param[in] value Value of the enumerator.
+ * @return If the value has an enumerator, returns its name. Otherwise, returns an
+ *     empty view.
+ */
+template<typename Enum>
+    requires std::is_enum_v<Enum>
+[[nodiscard]]
+constexpr auto enum_name(Enum value) noexcept -> std::string_view {
+    constexpr auto const& names = enum_names_v<Enum>;
+    auto const index = static_cast<std::size_t>(value);
+    return index < names.size() ? names[index] : std::string_view{};
+}
+
+/**
+ * @brief Returns the enumerator with the given name, see enum_names_v.
+ * @details Looks up the name by a perfect hash that is generated at compile time, see
+ *     util::perfect_index.
+ * @tparam Enum Enumeration type.
+ * @param[in] name Name of the enumerator.
+ * @return If an enumerator was found, returns it. Otherwise, returns an empty optional.
+ */
+template<typename Enum>
+    requires std::is_enum_v<Enum>
+[[nodiscard]]
+constexpr auto enum_cast(std::string_view name) noexcept -> std::optional<Enum> {
+    auto const index = detail::enum_index_v<Enum>.find(name);
+    if (index == enum_names_v<Enum>.size()) return std::nullopt;
+    return static_cast<Enum>(index);
+}
+
+/**
+ * @brief Returns a reference to the member of a nested aggregate with the given path.
+ * @details Resolves the path at compile time, so that the access compiles to a plain
+ *     member access. A path that does not name a member fails to compile.
+ * @tparam Path Names of the nested members, separated by dots, e.g. "frame.width".
+ * @tparam Begin Offset of the part of the path that is yet to be resolved.
+ * @tparam T Aggregate type, possibly const-qualified.
+ * @param[in] aggregate Aggregate to refer to the member of.
+ */
+template<util::fixed_string Path, std::size_t Begin = 0, typename T>
+[[nodiscard]]
+constexpr auto get(T& aggregate) noexcept -> auto& {
+    constexpr auto path = Path.view();
+    constexpr auto end = std::min(path.find('.', Begin), path.size());
+    constexpr auto index = member_index<T>(path.substr(Begin, end - Begin));
+    static_assert(index < member_count_v<T>, "path does not name a member");
+
+    auto& member = std::get<index>(tie(aggregate));
+    if constexpr (end == path.size()) return member;
+    else return get<Path, end + 1>(member);
+}
+
+} // namespace refl
+
+#endif
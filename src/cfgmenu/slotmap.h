@@ -0,0 +1,280 @@
+/**
+ * @file       slotmap.h
+ * @version    0.1
+ * @date       June 2022
+ * @author     Joeri Kok
+ * @author     Rick Horeman
+ * @copyright  GPL-3.0 license
+ *
+ * @brief Container with stable handles.
+ */
+
+#ifndef UTIL_SLOTMAP_H
+#define UTIL_SLOTMAP_H
+
+#include "types.h"
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace util
+ * @brief Utility related components.
+ */
+namespace util {
+
+/**
+ * @class slot_map
+ * @brief Container that refers to its elements by generational handles.
+ * @details Elements are stored in slots that are reused after their element is erased.
+ *     A handle remains valid until its element is erased, regardless of any other
+ *     insertion or erasure, and is detected as stale afterwards. Inserting and erasing
+ *     an element take constant time and never move any other element between slots.
+ *     Iteration visits the elements in order of insertion.
+ * @tparam T Element type.
+ */
+template<typename T>
+class slot_map {
+    /**
+     * @brief Index that refers to no slot.
+     */
+    static constexpr auto npos = std::numeric_limits<uint32>::max();
+
+public:
+    /**
+     * @struct handle
+     * @brief Refers to an element of a slot map.
+     */
+    struct handle {
+        /**
+         * @brief Compares two objects for equality.
+         */
+        [[nodiscard]]
+        friend auto operator==(handle const&, handle const&) -> bool = default;
+
+        uint32 index{npos};  /**< Index of the slot of the element. */
+        uint32 generation{}; /**< Generation of the slot when the element was inserted. */
+    };
+
+    /**
+     * @class basic_iterator
+     * @brief Iterates over the elements in order of insertion.
+     * @tparam Const Whether the elements are accessed as const.
+     */
+    template<bool Const>
+    class basic_iterator {
+        using map_type = std::conditional_t<Const, slot_map const, slot_map>;
+
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, T const&, T&>;
+
+        /**
+         * @brief Default constructs an iterator.
+         */
+        basic_iterator() = default;
+
+        /**
+         * @brief Constructs an iterator to the element in the given slot.
+         */
+        constexpr basic_iterator(map_type* map, uint32 index) noexcept:
+            map_{map},
+            index_{index}
+        {}
+
+        /**
+         * @brief Returns a reference to the current element.
+         */
+        [[nodiscard]]
+        constexpr auto operator*() const noexcept -> reference
+        { return *map_->slots_[index_].value; }
+
+        /**
+         * @brief Advances the iterator to the next element.
+         */
+        constexpr auto operator++() noexcept -> basic_iterator& {
+            index_ = map_->slots_[index_].next;
+            return *this;
+        }
+
+        /**
+         * @brief Advances the iterator to the next element.
+         */
+        constexpr auto operator++(int) noexcept -> basic_iterator {
+            auto const previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        /**
+         * @brief Returns the handle of the current element.
+         */
+        [[nodiscard]]
+        constexpr auto key() const noexcept -> handle
+        { return {index_, map_->slots_[index_].generation}; }
+
+        /**
+         * @brief Compares two objects for equality.
+         */
+        [[nodiscard]]
+        friend auto operator==(basic_iterator const&, basic_iterator const&) -> bool
+            = default;
+
+    private:
+        map_type* map_{}; /**< Iterated slot map. */
+        uint32 index_{};  /**< Index of the slot of the current element. */
+    };
+
+    using iterator = basic_iterator<false>;      /**< Iterator type. */
+    using const_iterator = basic_iterator<true>; /**< Const iterator type. */
+
+    /**
+     * @brief Constructs an element in place, after all other elements.
+     * @tparam Ts Argument types.
+     * @param[in] args Arguments to construct the element with.
+     * @return Handle of the inserted element.
+     */
+    template<typename... Ts>
+    constexpr auto emplace(Ts&&... args) -> handle {
+        auto index = free_;
+        if (index == npos) {
+            index = static_cast<uint32>(slots_.size());
+            slots_.emplace_back();
+        } else {
+            free_ = slots_[index].next;
+        }
+        auto& slot = slots_[index];
+        slot.value.emplace(std::forward<Ts>(args)...);
+        slot.prev = tail_;
+        slot.next = npos;
+        (tail_ == npos ? head_ : slots_[tail_].next) = index;
+        tail_ = index;
+        ++size_;
+        return {index, slot.generation};
+    }
+
+    /**
+     * @brief Erases the element the given handle refers to, if any.
+     * @param[in] key Handle of the element to erase.
+     * @return If an element was erased, returns true. Otherwise, returns false.
+     */
+    constexpr auto erase(handle key) -> bool {
+        if (not contains(key)) return false;
+        auto& slot = slots_[key.index];
+        (slot.prev == npos ? head_ : slots_[slot.prev].next) = slot.next;
+        (slot.next == npos ? tail_ : slots_[slot.next].prev) = slot.prev;
+        slot.value.reset();
+        ++slot.generation;
+        slot.next = free_;
+        free_ = key.index;
+        --size_;
+        return true;
+    }
+
+    /**
+     * @brief Returns whether the given handle refers to an element.
+     * @param[in] key Handle to check.
+     */
+    [[nodiscard]]
+    constexpr auto contains(handle key) const noexcept -> bool {
+        return key.index < slots_.size()
+            and slots_[key.index].generation == key.generation
+            and slots_[key.index].value.has_value();
+    }
+
+    /**
+     * @brief Returns a reference to the element the given handle refers to.
+     * @pre Ensure the handle refers to an element before calling this function.
+     * @{
+     */
+    [[nodiscard]]
+    constexpr auto operator[](handle key) noexcept -> T&
+    { return *slots_[key.index].value; }
+
+    [[nodiscard]]
+    constexpr auto operator[](handle key) const noexcept -> T const&
+    { return *slots_[key.index].value; }
+    /** @} */
+
+    /**
+     * @brief Returns the number of elements.
+     */
+    [[nodiscard]]
+    constexpr auto size() const noexcept -> std::size_t
+    { return size_; }
+
+    /**
+     * @brief Returns whether the slot map contains no elements.
+     */
+    [[nodiscard]]
+    constexpr auto empty() const noexcept -> bool
+    { return size_ == 0; }
+
+    /**
+     * @brief Returns an iterator to the first inserted element.
+     * @{
+     */
+    [[nodiscard]]
+    constexpr auto begin() noexcept -> iterator
+    { return {this, head_}; }
+
+    [[nodiscard]]
+    constexpr auto begin() const noexcept -> const_iterator
+    { return {this, head_}; }
+    /** @} */
+
+    /**
+     * @brief Returns an iterator past the last inserted element.
+     * @{
+     */
+    [[nodiscard]]
+    constexpr auto end() noexcept -> iterator
+    { return {this, npos}; }
+
+    [[nodiscard]]
+    constexpr auto end() const noexcept -> const_iterator
+    { return {this, npos}; }
+    /** @} */
+
+    /**
+     * @brief Slot maps are considered to be equal when their elements are equal, in
+     *     order of insertion.
+     */
+    [[nodiscard]]
+    friend constexpr auto operator==(slot_map const& lhs, slot_map const& rhs) -> bool {
+        if (lhs.size() != rhs.size()) return false;
+        for (auto l = lhs.begin(), r = rhs.begin(); l != lhs.end(); ++l, ++r) {
+            if (not (*l == *r)) return false;
+        }
+        return true;
+    }
+
+private:
+    /**
+     * @struct slot
+     * @brief Holds an element and links it to its neighbours in order of insertion.
+     * @details The next index of an empty slot links it to the next empty slot.
+     */
+    struct slot {
+        std::optional<T> value; /**< Element, if any. */
+        uint32 generation{};    /**< Incremented whenever the element is erased. */
+        uint32 prev{npos};      /**< Slot of the previously inserted element. */
+        uint32 next{npos};      /**< Slot of the next inserted element. */
+    };
+
+    std::vector<slot> slots_; /**< Slots, both empty and occupied. */
+    uint32 head_{npos};       /**< Slot of the first inserted element. */
+    uint32 tail_{npos};       /**< Slot of the last inserted element. */
+    uint32 free_{npos};       /**< First empty slot. */
+    std::size_t size_{};      /**< Number of elements. */
+};
+
+} // namespace util
+
+#endif
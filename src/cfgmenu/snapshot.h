@@ -0,0 +1,207 @@
+/**
+ * @file       snapshot.h
+ * @version    0.1
+ * @date       June 2022
+ * @author     Joeri Kok
+ * @author     Rick Horeman
+ * @copyright  GPL-3.0 license
+ *
+ * @brief Publication of immutable configuration snapshots across threads.
+ */
+
+#ifndef CFG_SNAPSHOT_H
+#define CFG_SNAPSHOT_H
+
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+/**
+ * @namespace cfg
+ * @brief Configuration related components.
+ */
+namespace cfg {
+
+template<typename T>
+class publisher;
+
+/**
+ * @class snapshot
+ * @brief Read access to a published value.
+ * @details Keeps the value alive for as long as the snapshot exists. Snapshots are
+ *     meant to be short-lived, e.g. held for the duration of a single frame, since a
+ *     publisher waits for outstanding snapshots before it reclaims a replaced value.
+ * @tparam T Type of the published value.
+ */
+template<typename T>
+class snapshot {
+public:
+    snapshot(snapshot const&) = delete;
+    auto operator=(snapshot const&) -> snapshot& = delete;
+
+    /**
+     * @brief Move constructs a snapshot, leaving the other snapshot empty.
+     */
+    snapshot(snapshot&& other) noexcept:
+        value_{std::exchange(other.value_, nullptr)},
+        readers_{std::exchange(other.readers_, nullptr)}
+    {}
+
+    /**
+     * @brief Move assigns a snapshot, leaving the other snapshot empty.
+     */
+    auto operator=(snapshot&& other) noexcept -> snapshot& {
+        release();
+        value_ = std::exchange(other.value_, nullptr);
+        readers_ = std::exchange(other.readers_, nullptr);
+        return *this;
+    }
+
+    /**
+     * @brief Releases the snapshot.
+     */
+    ~snapshot()
+    { release(); }
+
+    /**
+     * @brief Returns a reference to the published value.
+     */
+    [[nodiscard]]
+    auto operator*() const noexcept -> T const&
+    { return *value_; }
+
+    /**
+     * @brief Returns a pointer to the published value.
+     */
+    [[nodiscard]]
+    auto operator->() const noexcept -> T const*
+    { return value_; }
+
+private:
+    friend class publisher<T>;
+
+    /**
+     * @brief Constructs a snapshot of a value that is registered by a reader count.
+     */
+    snapshot(T const* value, std::atomic<std::size_t>& readers) noexcept:
+        value_{value},
+        readers_{std::addressof(readers)}
+    {}
+
+    /**
+     * @brief Unregisters the snapshot from the reader count, if not empty.
+     */
+    auto release() noexcept -> void {
+        if (readers_ == nullptr) return;
+        readers_->fetch_sub(1);
+        readers_ = nullptr;
+    }
+
+    T const* value_;                    /**< Published value. */
+    std::atomic<std::size_t>* readers_; /**< Reader count the snapshot is registered by. */
+};
+
+/**
+ * @class publisher
+ * @brief Publishes immutable snapshots of a value to concurrent readers.
+ * @details Readers are wait-free: taking a snapshot costs a single atomic increment
+ *     and a load, and never blocks on a writer. Writers build a new value, publish it
+ *     with a single atomic pointer swap, and then wait for the readers that may still
+ *     refer to the replaced value before reclaiming it. Writers are serialized.
+ * @tparam T Type of the published value.
+ */
+template<typename T>
+class publisher {
+public:
+    /**
+     * @brief Constructs a publisher with the given initial value.
+     * @param[in] value Value to publish initially.
+     */
+    explicit publisher(T value):
+        current_{new T const(std::move(value))}
+    {}
+
+    publisher(publisher const&) = delete;
+    auto operator=(publisher const&) -> publisher& = delete;
+
+    /**
+     * @brief Destroys the published value.
+     * @pre Ensure no snapshots are outstanding.
+     */
+    ~publisher()
+    { delete current_.load(); }
+
+    /**
+     * @brief Returns a snapshot of the currently published value.
+     */
+    [[nodiscard]]
+    auto read() const noexcept -> snapshot<T> {
+        auto& readers = readers_[phase_.load() % readers_.size()].count;
+        readers.fetch_add(1);
+        return {current_.load(), readers};
+    }
+
+    /**
+     * @brief Publishes a new value.
+     * @details Blocks until no reader refers to the replaced value anymore.
+     * @param[in] value Value to publish.
+     */
+    auto publish(T value) -> void {
+        auto next = std::make_unique<T const>(std::move(value));
+        auto const lock = std::scoped_lock{writer_};
+        reclaim(current_.exchange(next.release()));
+    }
+
+    /**
+     * @brief Publishes a modified copy of the currently published value.
+     * @details Writers are serialized, so no concurrent update can get lost.
+     * @tparam Function Callable type, required to be invocable with a reference to
+     *     the value to publish.
+     * @param[in] function Callable that modifies the value to publish.
+     */
+    template<std::invocable<T&> Function>
+    auto update(Function&& function) -> void {
+        auto const lock = std::scoped_lock{writer_};
+        auto next = std::make_unique<T>(*current_.load());
+        std::invoke(std::forward<Function>(function), *next);
+        reclaim(current_.exchange(next.release()));
+    }
+
+private:
+    /**
+     * @brief Reclaims a replaced value after all readers that may refer to it are done.
+     * @details Flips the reader phase twice and waits for the readers of each phase to
+     *     drain, so that new readers never hold up a writer.
+     * @param[in] previous Replaced value.
+     */
+    auto reclaim(T const* previous) noexcept -> void {
+        for (auto flip = 0; flip < 2; ++flip) {
+            auto const& readers = readers_[phase_.fetch_add(1) % readers_.size()].count;
+            while (readers.load() != 0) std::this_thread::yield();
+        }
+        delete previous;
+    }
+
+    /**
+     * @struct reader_count
+     * @brief Number of readers in a phase, on a cache line of its own.
+     */
+    struct alignas(64) reader_count {
+        std::atomic<std::size_t> count; /**< Number of outstanding snapshots. */
+    };
+
+    std::atomic<T const*> current_;                 /**< Published value. */
+    mutable std::atomic<std::size_t> phase_;        /**< Current reader phase. */
+    mutable std::array<reader_count, 2> readers_{}; /**< Reader counts per phase. */
+    std::mutex writer_;                             /**< Serializes writers. */
+};
+
+} // namespace cfg
+
+#endif
@@ -32,6 +32,10 @@ struct is_distinct
         std::negation<std::is_same<T, Ts>>...,
         is_distinct<Ts...>> {};
 
+template<typename T>
+struct is_distinct<T>
+    : std::true_type {};
+
 template<typename T1, typename T2>
 struct is_distinct<T1, T2>
     : std::negation<std::is_same<T1, T2>> {};
@@ -12,6 +12,14 @@
 #ifndef UTIL_UTILITY_H
 #define UTIL_UTILITY_H
 
+#include "types.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <string_view>
+
 /**
  * @namespace util
  * @brief Utility related components.
@@ -35,6 +43,133 @@ struct visitor : Ts... {
     using Ts::operator()...;
 };
 
+/**
+ * @brief Computes the 64-bit FNV-1a hash of the given bytes.
+ * @param[in] bytes Bytes to hash.
+ * @param[in] hash Hash to continue from. Defaulted to the FNV offset basis.
+ */
+[[nodiscard]]
+constexpr auto fnv1a(std::string_view bytes, uint64 hash = 0xcbf2'9ce4'8422'2325) noexcept
+    -> uint64
+{
+    for (auto const byte : bytes) {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= 0x100'0000'01b3;
+    }
+    return hash;
+}
+
+/**
+ * @struct fixed_string
+ * @brief String of fixed size that can be used as a template argument.
+ * @tparam N Size of the string, including the null-terminator.
+ */
+template<std::size_t N>
+struct fixed_string {
+    /**
+     * @brief Constructs a fixed string from a string literal.
+     * @param[in] str String literal to copy.
+     */
+    constexpr fixed_string(char const (&str)[N]) noexcept
+    { std::ranges::copy(str, data); }
+
+    /**
+     * @brief Returns a view of the string, excluding the null-terminator.
+     */
+    [[nodiscard]]
+    constexpr auto view() const noexcept -> std::string_view
+    { return {data, N - 1}; }
+
+    /**
+     * @brief Compares two objects for equality.
+     */
+    [[nodiscard]]
+    friend auto operator==(fixed_string const&, fixed_string const&) -> bool = default;
+
+    char data[N]; /**< Characters of the string. */
+};
+
+/**
+ * @class perfect_index
+ * @brief Maps a fixed set of keys to their indices by a perfect hash.
+ * @details Searches at compile time for a seed of the FNV-1a hash that maps every key
+ *     to a slot of its own, so that finding a key takes a single hash and a single
+ *     comparison, without allocating.
+ * @tparam N Number of keys.
+ */
+template<std::size_t N>
+class perfect_index {
+    /**
+     * @brief Number of slots; sparse enough that a seed is found after a few attempts.
+     */
+    static constexpr auto slots = std::bit_ceil(4 * N);
+
+    /**
+     * @brief Shift that keeps the upper bits of a hash, which are mixed the best.
+     */
+    static constexpr auto shift = 64 - std::countr_zero(slots);
+
+    /**
+     * @brief Value of an empty slot.
+     */
+    static constexpr auto empty = uint16{0xffff};
+
+    static_assert(N < empty, "too many keys to index");
+
+public:
+    /**
+     * @brief Constructs an index of the given keys.
+     * @param[in] keys Distinct keys to index, referring to storage with static duration.
+     */
+    consteval explicit perfect_index(std::array<std::string_view, N> const& keys):
+        keys_{keys}
+    {
+        for (seed_ = 1; not fill(); ++seed_) {
+            if (seed_ == 10'000) throw "no perfect hash found for the keys";
+        }
+    }
+
+    /**
+     * @brief Returns the index of the given key.
+     * @param[in] key Key to find.
+     * @return If the key was found, returns its index. Otherwise, returns the number of
+     *     keys.
+     */
+    [[nodiscard]]
+    constexpr auto find(std::string_view key) const noexcept -> std::size_t {
+        auto const index = slots_[slot(key)];
+        if (index == empty or keys_[index] != key) return N;
+        return index;
+    }
+
+private:
+    /**
+     * @brief Returns the slot of the given key, for the current seed.
+     * @param[in] key Key to hash.
+     */
+    [[nodiscard]]
+    constexpr auto slot(std::string_view key) const noexcept -> std::size_t
+    { return slots == 1 ? 0 : fnv1a(key, seed_) >> shift; }
+
+    /**
+     * @brief Fills the slots with the indices of the keys, for the current seed.
+     * @return If every key got a slot of its own, returns true. Otherwise, returns false.
+     */
+    constexpr auto fill() noexcept -> bool {
+        slots_.fill(empty);
+        for (auto index = std::size_t{}; index < N; ++index) {
+            auto& entry = slots_[slot(keys_[index])];
+            if (entry != empty) return false;
+            entry = static_cast<uint16>(index);
+        }
+        return true;
+    }
+
+    std::array<std::string_view, N> keys_; /**< Indexed keys. */
+    std::array<uint16, slots> slots_{};    /**< Index of the key in each slot. */
+    uint64 seed_{};                        /**< Seed of the hash. */
+};
+
 } // namespace util
 
 #endif
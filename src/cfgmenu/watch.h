@@ -0,0 +1,245 @@
+/**
+ * @file       watch.h
+ * @version    0.1
+ * @date       June 2022
+ * @author     Joeri Kok
+ * @author     Rick Horeman
+ * @copyright  GPL-3.0 license
+ *
+ * @brief Reloading of the configuration settings when the XML file changes.
+ * @note Relies on inotify, and is therefore only available on Linux.
+ */
+
+#ifndef CFG_WATCH_H
+#define CFG_WATCH_H
+
+#include "config.h"
+#include "types.h"
+#include "utility.h"
+#include "xml.h"
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace cfg
+ * @brief Configuration related components.
+ */
+namespace cfg {
+
+/**
+ * @class xmlwatch
+ * @brief Watches the XML file of the configuration settings for changes.
+ * @details Reparses the file on a background thread whenever it is written or replaced.
+ *     The parsed settings are held until the owner of the configuration polls for them,
+ *     which applies all of them at once, on the owner's thread. Documents that were
+ *     written by the application itself are not reloaded, see ignore. When events
+ *     were lost because the event queue overflowed, the file is reloaded as well.
+ */
+class xmlwatch {
+public:
+    /**
+     * @brief Starts watching the XML file of the given configuration.
+     * @param[in] xml XML related configuration, containing the file and tag names.
+     * @throw std::system_error When the file could not be watched.
+     */
+    explicit xmlwatch(xmlcfg const& xml):
+        path_{ofToDataPath(xml.filename)},
+        tagname_{xml.tagname}
+    {
+        auto const file = std::filesystem::path{path_};
+        auto const directory = file.has_parent_path() ? file.parent_path() : ".";
+        filename_ = file.filename().string();
+
+        if (::inotify_add_watch(inotify_.get(), directory.c_str(),
+                IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+            throw std::system_error{errno, std::system_category(), "inotify_add_watch"};
+        }
+        worker_ = std::jthread{[this](std::stop_token stop) { watch(std::move(stop)); }};
+    }
+
+    xmlwatch(xmlwatch const&) = delete;
+    auto operator=(xmlwatch const&) -> xmlwatch& = delete;
+
+    /**
+     * @brief Ignores changes of the XML file to the given document, e.g. because the
+     *     application is about to write it itself. Thread-safe.
+     * @details Only the most recently given document is ignored.
+     * @param[in] hash Hash of the document to ignore, see util::fnv1a.
+     */
+    auto ignore(uint64 hash) noexcept -> void
+    { ignored_.store(hash); }
+
+    /**
+     * @brief Returns whether the XML file is still watched. Thread-safe.
+     * @details The watch ends when the directory of the file is removed or unmounted,
+     *     or when waiting for changes fails, after which changes are no longer reloaded.
+     */
+    [[nodiscard]]
+    auto watching() const noexcept -> bool
+    { return watching_.load(); }
+
+    /**
+     * @brief Applies the most recently reloaded settings, if any.
+     * @details Only changes the configuration items whose value differs, and leaves the
+     *     dirty ones as they are, see config::fromxml. Reloaded items are no longer
+     *     dirty. Meant to be called regularly by the owner of the configuration, e.g.
+     *     once per frame.
+     * @param[in] settings Configuration settings to apply the reloaded settings to.
+     * @return Number of configuration items that changed.
+     */
+    auto poll(config& settings) -> std::size_t {
+        if (not ready_.load()) return 0;
+        auto values = [this] {
+            auto const lock = std::scoped_lock{mutex_};
+            ready_.store(false);
+            return std::exchange(pending_, {});
+        }();
+        auto changed = std::size_t{};
+        for (auto const& [tag, value] : values) {
+            changed += settings.fromxml(tag, value);
+        }
+        return changed;
+    }
+
+private:
+    /**
+     * @typedef values_type
+     * @brief Pairs of tag names and values, in document order.
+     */
+    using values_type = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * @class descriptor
+     * @brief Owns a file descriptor.
+     */
+    class descriptor {
+    public:
+        /**
+         * @brief Takes ownership of the given file descriptor.
+         * @throw std::system_error When the file descriptor is invalid.
+         */
+        explicit descriptor(int fd):
+            fd_{fd}
+        { if (fd_ < 0) throw std::system_error{errno, std::system_category()}; }
+
+        descriptor(descriptor const&) = delete;
+        auto operator=(descriptor const&) -> descriptor& = delete;
+
+        /**
+         * @brief Closes the file descriptor.
+         */
+        ~descriptor()
+        { ::close(fd_); }
+
+        /**
+         * @brief Returns the file descriptor.
+         */
+        [[nodiscard]]
+        auto get() const noexcept -> int
+        { return fd_; }
+
+    private:
+        int fd_; /**< Owned file descriptor. */
+    };
+
+    /**
+     * @brief Waits for changes to the XML file until a stop is requested, or until the
+     *     watch ends, see watching.
+     * @param[in] stop Token to observe a stop request with.
+     */
+    auto watch(std::stop_token stop) -> void {
+        auto const wake = std::stop_callback{stop, [this] {
+            auto const one = uint64{1};
+            static_cast<void>(::write(stop_.get(), &one, sizeof(one)));
+        }};
+        auto fds = std::array{
+            ::pollfd{.fd = inotify_.get(), .events = POLLIN, .revents = 0},
+            ::pollfd{.fd = stop_.get(), .events = POLLIN, .revents = 0}};
+        alignas(::inotify_event) auto buffer = std::array<char, 4096>{};
+
+        while (not stop.stop_requested()) {
+            if (::poll(fds.data(), fds.size(), -1) < 0) {
+                if (errno == EINTR) continue;
+                watching_.store(false);
+                return;
+            }
+            if (fds[1].revents != 0) return;
+
+            auto const size = ::read(inotify_.get(), buffer.data(), buffer.size());
+            if (size <= 0) continue;
+
+            auto changed = false;
+            auto ignored = false;
+            for (auto offset = std::size_t{}; offset < static_cast<std::size_t>(size);) {
+                auto event = ::inotify_event{};
+                std::memcpy(&event, buffer.data() + offset, sizeof(event));
+                if (event.len != 0) {
+                    auto const text = buffer.data() + offset + sizeof(event);
+                    auto const name = std::string_view{text, ::strnlen(text, event.len)};
+                    changed = changed or name == filename_;
+                }
+                changed = changed or (event.mask & IN_Q_OVERFLOW) != 0;
+                ignored = ignored or (event.mask & IN_IGNORED) != 0;
+                offset += sizeof(event) + event.len;
+            }
+            if (changed) reload();
+            if (ignored) {
+                watching_.store(false);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Reparses the XML file and hands over the parsed settings.
+     */
+    auto reload() -> void {
+        auto values = values_type{};
+        auto const document = xml::read(path_);
+        if (util::fnv1a(document) == ignored_.load()) return;
+        auto const complete = xml::parse(document, [this, &values](auto path, auto value) {
+            if (path.size() == 2 and path.front() == tagname_) {
+                values.emplace_back(path.back(), value);
+            }
+        });
+        if (not complete) return;
+
+        auto const lock = std::scoped_lock{mutex_};
+        pending_ = std::move(values);
+        ready_.store(true);
+    }
+
+    std::string path_;                                /**< Path of the XML file. */
+    std::string filename_;                            /**< File name of the XML file. */
+    std::string tagname_;                             /**< Top-level tag name. */
+    descriptor inotify_{::inotify_init1(IN_CLOEXEC)}; /**< Inotify instance. */
+    descriptor stop_{::eventfd(0, EFD_CLOEXEC)};      /**< Wakes up the worker. */
+    values_type pending_;                             /**< Reloaded settings. */
+    std::atomic<bool> ready_;                         /**< Reloaded settings are pending. */
+    std::atomic<uint64> ignored_;                     /**< Hash of the ignored document. */
+    std::atomic<bool> watching_{true};                /**< XML file is still watched. */
+    std::mutex mutex_;                                /**< Guards the pending settings. */
+    std::jthread worker_;                             /**< Watches the XML file. */
+};
+
+} // namespace cfg
+
+#endif
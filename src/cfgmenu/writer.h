@@ -0,0 +1,145 @@
+/**
+ * @file       writer.h
+ * @version    0.1
+ * @date       June 2022
+ * @author     Joeri Kok
+ * @author     Rick Horeman
+ * @copyright  GPL-3.0 license
+ *
+ * @brief Saving of the configuration settings in the background.
+ */
+
+#ifndef CFG_WRITER_H
+#define CFG_WRITER_H
+
+#include "config.h"
+#include "function.h"
+#include "types.h"
+#include "utility.h"
+#include "xml.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+/**
+ * @namespace cfg
+ * @brief Configuration related components.
+ */
+namespace cfg {
+
+/**
+ * @class xmlwriter
+ * @brief Saves the configuration settings to their XML file on a background thread.
+ * @details Bursts of saves are coalesced: the file is written at most once per interval,
+ *     with the most recently saved settings. Settings that fail to be written remain
+ *     pending, and are written again after the interval unless newer settings were
+ *     saved in the meantime. Pending settings are written before the writer is
+ *     destroyed.
+ */
+class xmlwriter {
+public:
+    /**
+     * @typedef observer
+     * @brief Callable that is invoked with the hash of every document right before it is
+     *     written, see util::fnv1a.
+     */
+    using observer = util::inplace_function<void(uint64)>;
+
+    /**
+     * @brief Starts a writer for the XML file of the given configuration.
+     * @param[in] xml XML related configuration, containing the file name.
+     * @param[in] interval Minimum time between two writes of the file.
+     * @param[in] writing Optional observer to invoke on the background thread before
+     *     every write, e.g. to let an xmlwatch ignore the written document.
+     */
+    explicit xmlwriter(
+        xmlcfg const& xml,
+        std::chrono::milliseconds interval = std::chrono::milliseconds{500},
+        observer writing = {}
+    ):
+        path_{ofToDataPath(xml.filename)},
+        interval_{interval},
+        writing_{std::move(writing)},
+        worker_{[this](std::stop_token stop) { write(std::move(stop)); }}
+    {}
+
+    xmlwriter(xmlwriter const&) = delete;
+    auto operator=(xmlwriter const&) -> xmlwriter& = delete;
+
+    /**
+     * @brief Saves the given configuration settings, if any setting changed or the file
+     *     does not exist yet.
+     * @details Only takes a copy of the settings and marks them as saved, so that the
+     *     caller never waits for the file to be written. Replaces settings that are
+     *     still pending.
+     * @param[in] settings Configuration settings to save.
+     */
+    auto save(config& settings) -> void {
+        auto error = std::error_code{};
+        if (not settings.dirty() and std::filesystem::exists(path_, error)) return;
+        {
+            auto const lock = std::scoped_lock{mutex_};
+            pending_ = settings;
+        }
+        settings.clean();
+        saved_.notify_one();
+    }
+
+    /**
+     * @brief Returns whether the most recent write of the file failed. Its settings
+     *     remain pending until a write succeeds.
+     */
+    [[nodiscard]]
+    auto failed() const noexcept -> bool
+    { return failed_.load(); }
+
+private:
+    /**
+     * @brief Writes pending settings until a stop is requested.
+     * @param[in] stop Token to observe a stop request with.
+     */
+    auto write(std::stop_token stop) -> void {
+        auto document = std::string{};
+        auto lock = std::unique_lock{mutex_};
+        while (true) {
+            saved_.wait(lock, stop, [this] { return pending_.has_value(); });
+            if (not pending_) return;
+
+            auto settings = *std::exchange(pending_, std::nullopt);
+            lock.unlock();
+            settings.toxml(document);
+            if (writing_) writing_(util::fnv1a(document));
+            auto const written = xml::write(path_, document);
+            lock.lock();
+
+            failed_.store(not written);
+            if (not written and not pending_ and not stop.stop_requested()) {
+                pending_ = std::move(settings);
+            }
+
+            saved_.wait_for(lock, stop, interval_, [] { return false; });
+        }
+    }
+
+    std::string path_;                   /**< Path of the XML file. */
+    std::chrono::milliseconds interval_; /**< Minimum time between two writes. */
+    observer writing_;                   /**< Invoked before every write. */
+    std::optional<config> pending_;      /**< Settings that are yet to be written. */
+    std::atomic<bool> failed_;           /**< Most recent write failed. */
+    std::mutex mutex_;                   /**< Guards the pending settings. */
+    std::condition_variable_any saved_;  /**< Signals pending settings. */
+    std::jthread worker_;                /**< Writes the XML file. */
+};
+
+} // namespace cfg
+
+#endif
@@ -0,0 +1,188 @@
+/**
+ * @file       xml.h
+ * @version    0.1
+ * @date       June 2022
+ * @author     Joeri Kok
+ * @author     Rick Horeman
+ * @copyright  GPL-3.0 license
+ *
+ * @brief Streaming XML reader.
+ */
+
+#ifndef XML_READER_H
+#define XML_READER_H
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+
+/**
+ * @namespace xml
+ * @brief XML related components.
+ */
+namespace xml {
+
+/**
+ * @typedef path
+ * @brief Tag names of the currently opened elements, ordered from outer to inner.
+ */
+using path = std::span<std::string_view const>;
+
+/**
+ * @brief Maximum nesting depth of the elements that can be parsed.
+ */
+inline constexpr auto max_depth = std::size_t{16};
+
+/**
+ * @brief Returns the given string without leading and trailing whitespace.
+ * @param[in] str String to trim.
+ */
+[[nodiscard]]
+constexpr auto trim(std::string_view str) noexcept -> std::string_view {
+    auto constexpr whitespace = std::string_view{" \t\r\n"};
+    auto const first = str.find_first_not_of(whitespace);
+    if (first == std::string_view::npos) return {};
+    return str.substr(first, str.find_last_not_of(whitespace) - first + 1);
+}
+
+/**
+ * @brief Returns whether the given string is a valid tag name.
+ * @details Accepts names that start with a letter or an underscore, followed by
+ *     letters, digits, hyphens, underscores, or periods. Non-ASCII characters are
+ *     accepted as letters. Colons are rejected, since namespaces are not supported.
+ * @param[in] name Name to check.
+ */
+[[nodiscard]]
+constexpr auto valid_name(std::string_view name) noexcept -> bool {
+    auto const letter = [](unsigned char c) {
+        return (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or c == '_' or c >= 0x80;
+    };
+    auto const namechar = [letter](unsigned char c) {
+        return letter(c) or (c >= '0' and c <= '9') or c == '-' or c == '.';
+    };
+    return not name.empty() and letter(static_cast<unsigned char>(name.front()))
+        and std::ranges::all_of(name, [namechar](char c)
+            { return namechar(static_cast<unsigned char>(c)); });
+}
+
+/**
+ * @brief Parses an XML document in a single pass, without building a DOM.
+ * @details Invokes the handler for every element that contains nothing but text, in
+ *     document order. The handler receives the path to the element, including the
+ *     element itself, and its text with surrounding whitespace trimmed. Declarations,
+ *     comments, and attributes are skipped. Entities are not expanded, and empty
+ *     elements, including those that contain nothing but whitespace, are not reported.
+ * @tparam Handler Callable type, required to be invocable with a path and a value.
+ * @param[in] document XML document to parse.
+ * @param[in] handler Callable to invoke for every text element.
+ * @return If the elements of the document are properly nested, returns true.
+ *     Otherwise, returns false.
+ */
+template<std::invocable<path, std::string_view> Handler>
+constexpr auto parse(std::string_view document, Handler&& handler) -> bool {
+    auto tags = std::array<std::string_view, max_depth>{};
+    auto depth = std::size_t{};
+    auto content = std::size_t{};
+    auto leaf = false;
+
+    auto const skip = [document](std::size_t pos, std::string_view delim) {
+        auto const end = document.find(delim, pos);
+        return end == std::string_view::npos ? end : end + delim.size();
+    };
+    auto const tagname = [](std::string_view tag) {
+        return tag.substr(0, tag.find_first_of(" \t\r\n/"));
+    };
+
+    for (auto pos = document.find('<'); pos != std::string_view::npos;
+         pos = document.find('<', pos))
+    {
+        auto const markup = document.substr(pos);
+
+        if (markup.starts_with("<?")) {
+            pos = skip(pos, "?>");
+        } else if (markup.starts_with("<!--")) {
+            pos = skip(pos, "-->");
+        } else if (markup.starts_with("<!")) {
+            pos = skip(pos, ">");
+        } else if (markup.starts_with("</")) {
+            auto const end = document.find('>', pos);
+            if (end == std::string_view::npos or depth == 0) return false;
+            auto const tag = trim(document.substr(pos + 2, end - pos - 2));
+            if (tag != tags[depth - 1]) return false;
+            if (leaf) {
+                auto const text = trim(document.substr(content, pos - content));
+                if (not text.empty()) handler(path{tags.data(), depth}, text);
+            }
+            leaf = false;
+            --depth;
+            pos = end + 1;
+        } else {
+            auto const end = document.find('>', pos);
+            if (end == std::string_view::npos) return false;
+            auto const tag = document.substr(pos + 1, end - pos - 1);
+            leaf = not tag.ends_with('/');
+            if (leaf) {
+                if (depth == max_depth) return false;
+                tags[depth++] = tagname(tag);
+                content = end + 1;
+            }
+            pos = end + 1;
+        }
+    }
+    return depth == 0;
+}
+
+/**
+ * @brief Reads the entire contents of a file with a single read.
+ * @param[in] filename Name of the file to read.
+ * @return Contents of the file, or an empty string if the file could not be read.
+ */
+[[nodiscard]]
+inline auto read(std::string const& filename) -> std::string {
+    auto file = std::ifstream{filename, std::ios::binary | std::ios::ate};
+    if (not file) return {};
+    auto contents = std::string(static_cast<std::size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+    return contents;
+}
+
+/**
+ * @brief Replaces the contents of a file, without ever leaving it partially written.
+ * @details Writes the contents to a temporary file next to the file, flushes it to the
+ *     storage device, and then renames it over the file.
+ * @param[in] filename Name of the file to write.
+ * @param[in] contents Contents to write.
+ * @return If the file was replaced, returns true. Otherwise, returns false.
+ */
+inline auto write(std::string const& filename, std::string_view contents) -> bool {
+    auto const temporary = filename + ".tmp";
+    auto const fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) return false;
+
+    while (not contents.empty()) {
+        auto const written = ::write(fd, contents.data(), contents.size());
+        if (written < 0 and errno == EINTR) continue;
+        if (written < 0) break;
+        contents.remove_prefix(static_cast<std::size_t>(written));
+    }
+    auto const complete = contents.empty() and ::fsync(fd) == 0;
+    if (::close(fd) == 0 and complete) {
+        return ::rename(temporary.c_str(), filename.c_str()) == 0;
+    }
+    ::unlink(temporary.c_str());
+    return false;
+}
+
+} // namespace xml
+
+#endif